@@ -30,6 +30,11 @@
 //comment out this line to switch back to the original output pins.
 #define ENABLE_FAST_OUTPUT
 
+//ENABLE_USART_OUTPUT shifts the pixels out of the USART in master SPI mode
+//instead of bit banging them (ATmega328/168 only). Video is on TXD (pin 1)
+//and XCK (pin 4) is driven as pixel clock, both can't be used otherwise.
+//#define ENABLE_USART_OUTPUT
+
 #ifndef HARDWARE_SETUP_H
 #define HARDWARE_SETUP_H
 
@@ -76,7 +81,13 @@
 
 #elif defined(__AVR_ATmega8__) || defined(__AVR_ATmega88__) || defined(__AVR_ATmega168P__) || defined(__AVR_ATmega168__) || defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__)
 //video
-#if defined(ENABLE_FAST_OUTPUT)
+#if defined(ENABLE_USART_OUTPUT)
+#define PORT_VID	PORTD
+#define	DDR_VID		DDRD
+#define	VID_PIN		1
+#define DDR_XCK		DDRD
+#define XCK_PIN		4
+#elif defined(ENABLE_FAST_OUTPUT)
 #define PORT_VID	PORTD
 #define	DDR_VID		DDRD
 #define	VID_PIN		7
@@ -42,6 +42,8 @@ void (*render_line)();			//remove me
 void (*line_handler)();			//remove me
 void (*hbi_hook)() = &empty;
 void (*vbi_hook)() = &empty;
+uint8_t render_cycles_per_pixel;
+uint8_t line_captured = 0;
 
 // sound properties
 volatile long remainingToneVsyncs;
@@ -66,6 +68,25 @@ void render_setup(uint8_t mode, uint8_t x, uint8_t y, uint8_t *scrnptr) {
 	//as of 9/16/10 rendermode 3 will not work for resolutions lower than
 	//192(display.hres lower than 24)
 	unsigned char rmethod = (_TIME_ACTIVE*_CYCLES_PER_US)/(display.hres*8);
+#if defined(ENABLE_USART_OUTPUT)
+	//the usart shifts a bit every 2*(UBRR0+1) cycles, so take the widest
+	//even pixel that fits. 128 pixels end up at 4 cycles, leaving a third
+	//of the active line to the cpu.
+	if (rmethod > 8)
+		rmethod = 8;
+	rmethod &= ~1;
+	if (rmethod < 2)
+		rmethod = 2;
+	render_line = &render_line_usart;
+	render_cycles_per_pixel = rmethod;
+
+	//master spi mode, msb first. xck has to be an output for master mode.
+	UBRR0 = 0;
+	DDR_XCK |= _BV(XCK_PIN);
+	UCSR0C = _BV(UMSEL01) | _BV(UMSEL00);
+	UCSR0B = 0;
+	UBRR0 = rmethod/2 - 1;
+#else
 	switch(rmethod) {
 		case 6:
 			render_line = &render_line6c;
@@ -85,6 +106,12 @@ void render_setup(uint8_t mode, uint8_t x, uint8_t y, uint8_t *scrnptr) {
 			else
 				render_line = &render_line3c;
 	}
+	if (rmethod > 6)
+		rmethod = 6;
+	else if (rmethod < 3)
+		rmethod = 3;
+	render_cycles_per_pixel = rmethod;
+#endif
 
     // Pin setup
 	DDR_VID |= _BV(VID_PIN);
@@ -179,15 +206,28 @@ void select_clock(uint8_t mode)
 }
 
 // ISR function for vertical handline, only required for exernal vsync
+// Runs the vsync line handler next, so the frame counter keeps counting and
+// forced timings work as with the internal clock.
 void vertical_handle() {
     if(display.clock_source) // externa vsync ONLY if required
     {
-        display.scanLine = 0;
+        display.scanLine = display.lines_frame;
+        line_handler = &vsync_line;
     }
 }
 
+// the usart transmitter drives the video pin high while idle, it is handed
+// back to the port (low) after the trailing black byte of the last line.
+static void inline usart_idle() {
+#if defined(ENABLE_USART_OUTPUT)
+	UCSR0B = 0;
+#endif
+}
+
 // render a line based on timer (free running)
 ISR(TIMER1_OVF_vect) {
+	usart_idle();
+	line_captured = 0;
     // original TVOUT handler
  	hbi_hook();
 	line_handler();
@@ -198,8 +238,29 @@ ISR(TIMER1_OVF_vect) {
 }
 
 // render a line based on external sync signal
+// Equalizing and broad pulses come every half line during vertical sync and
+// are skipped. The first full line after them starts the frame, so only the
+// composite sync is needed without a separate vsync input.
 ISR(TIMER1_CAPT_vect) {
+    static uint8_t half_lines = 0;
+
     TCNT1 -= ICR1;
+    usart_idle();
+
+    const uint16_t line_cycles = display.video_mode ?
+        _PAL_CYCLES_SCANLINE : _NTSC_CYCLES_SCANLINE;
+    if (ICR1 < line_cycles * 3 / 4) {
+        if (half_lines < 255)
+            half_lines++;
+        return;
+    }
+
+    if (half_lines > 0) {
+        half_lines = 0;
+        vertical_handle();
+    }
+
+    line_captured = 1;
  	hbi_hook();
 	line_handler();
 }
@@ -549,3 +610,22 @@ void render_line3c() {
 	);
 	#endif
 }
+
+
+// feeds the usart from the line buffer. It holds one byte while shifting the
+// previous, so the interrupt returns as soon as the last byte is queued.
+void render_line_usart() {
+#if defined(ENABLE_USART_OUTPUT)
+	const uint8_t * src = display.screen + renderLine;
+	uint8_t bytes = display.hres;
+
+	UCSR0B = _BV(TXEN0);
+	do {
+		while (!(UCSR0A & _BV(UDRE0)));
+		UDR0 = *src++;
+	} while (--bytes);
+
+	while (!(UCSR0A & _BV(UDRE0)));
+	UDR0 = 0;
+#endif
+}
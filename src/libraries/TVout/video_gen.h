@@ -48,6 +48,12 @@ extern TVout_vid display;
 
 extern void (*hbi_hook)();
 extern void (*vbi_hook)();
+
+// cpu cycles per pixel of the selected renderer
+extern uint8_t render_cycles_per_pixel;
+// set while the current line was started by captured sync, with the
+// external clock lines otherwise only come from timer1 overflowing.
+extern uint8_t line_captured;
 // genlock and video clock functions
 #define CLOCK_INTERN            0
 #define CLOCK_EXTERN            1
@@ -74,5 +80,6 @@ void render_line6c();
 void render_line5c();
 void render_line4c();
 void render_line3c();
+void render_line_usart();
 static void inline wait_until(uint8_t time);
 #endif
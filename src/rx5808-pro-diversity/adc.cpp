@@ -0,0 +1,338 @@
+#include <Arduino.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <util/atomic.h>
+#include <stdint.h>
+
+#include "adc.h"
+#include "settings.h"
+#include "settings_internal.h"
+
+
+// A conversion takes 13 ADC clocks at a prescaler of 128. Timer0, driving
+// millis(), runs at a prescaler of 64 and is halted during noise reduction
+// sleep, so it is moved forward by this many ticks after every conversion
+// slept through. That must not wrap it, as the overflow interrupt counting
+// millis() would be lost, so there is no sleeping from TIMER0_SLEEP_LIMIT on.
+// The slack covers the timer running on until the sleep and again from the
+// wake up through the ADC interrupt.
+#define CONVERSION_MICROS (13 * 128 / (F_CPU / 1000000UL))
+#define CONVERSION_TIMER0_TICKS (13 * 128 / 64)
+#define TIMER0_SLEEP_SLACK 8
+#define TIMER0_SLEEP_LIMIT \
+    (0xFF - CONVERSION_TIMER0_TICKS - TIMER0_SLEEP_SLACK)
+
+
+struct Slot {
+    uint8_t channel;
+    uint8_t samples;
+    uint8_t divider;
+};
+
+
+static Slot slots[ADC_SLOTS_MAX];
+static volatile uint16_t results[ADC_SLOTS_MAX] = { 0 };
+static uint8_t slotCount = 0;
+
+static volatile uint8_t currentSlot = 0;
+static volatile uint8_t sampleCount = 0;
+static volatile uint16_t sampleSum = 0;
+static volatile uint8_t discardCount = 0;
+static volatile uint16_t rotation = 0;
+
+static volatile bool running = false;
+static volatile bool pending = false;
+static volatile bool waiting = false;
+static volatile bool sleeping = false;
+static volatile bool converted = false;
+#ifdef ADC_LINE_TRIGGERED
+    static volatile bool lineTriggered = true;
+#endif
+
+
+static inline bool isSlotDue(uint8_t slot);
+static inline void selectSlot(uint8_t slot);
+static inline void convert();
+static inline void collect(const uint16_t value);
+static inline bool isLineTriggered();
+
+
+namespace Adc {
+    // Line triggered conversions must be done within a scanline, which
+    // takes a prescaler of 64. That is a 250kHz ADC clock, above the 200kHz
+    // the datasheet gives for full 10 bit accuracy, which costs some of the
+    // lowest bits. Oversampling and RSSI scaling don't need more.
+    void setup() {
+        #ifdef ADC_LINE_TRIGGERED
+            ADCSRA = _BV(ADEN) | _BV(ADPS2) | _BV(ADPS1);
+        #else
+            ADCSRA =
+                _BV(ADEN) | _BV(ADIE) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);
+        #endif
+    }
+
+    // The slot is converted every divider rotations. Slots which are not
+    // due are skipped, so the first slot should always be due.
+    uint8_t addSlot(uint8_t pin, uint8_t samples, uint8_t divider) {
+        if (pin >= A0)
+            pin -= A0;
+
+        slots[slotCount].channel = pin;
+        slots[slotCount].samples = samples;
+        slots[slotCount].divider = divider;
+
+        return slotCount++;
+    }
+
+    // Starts a new rotation unless one is still running. Called periodically,
+    // which also makes sure a pending conversion doesn't wait forever for
+    // the CPU to go idle.
+    void start() {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            if (running) {
+                if (pending) {
+                    pending = false;
+                    ADCSRA |= _BV(ADSC);
+                }
+
+                return;
+            }
+
+            if (slotCount == 0)
+                return;
+
+            running = true;
+            currentSlot = 0;
+            sampleCount = 0;
+            sampleSum = 0;
+            discardCount = 1;
+            selectSlot(0);
+
+            #if defined(ADC_NOISE_REDUCTION)
+                pending = true;
+            #else
+                if (isLineTriggered()) {
+                    waiting = true;
+                } else {
+                    ADCSRA |= _BV(ADSC);
+                }
+            #endif
+        }
+    }
+
+    // Drops the running rotation, for when inputs changed under it.
+    void restart() {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            if (!running) {
+                start();
+                return;
+            }
+
+            currentSlot = 0;
+            sampleCount = 0;
+            sampleSum = 0;
+            selectSlot(0);
+
+            // The conversion in flight and the one settling afterwards.
+            #ifdef ADC_LINE_TRIGGERED
+                const bool inFlight = ADCSRA & (_BV(ADSC) | _BV(ADIF));
+            #else
+                const bool inFlight = ADCSRA & _BV(ADSC);
+            #endif
+            discardCount = inFlight ? 2 : 1;
+        }
+    }
+
+    // Sum of all samples of the last rotation.
+    uint16_t getResult(uint8_t slot) {
+        uint16_t result;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            result = results[slot];
+        }
+
+        return result;
+    }
+
+    // Incremented after every completed rotation.
+    uint16_t getRotation() {
+        uint16_t result;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            result = rotation;
+        }
+
+        return result;
+    }
+
+    // Every 4x oversampling adds one bit, given there is enough noise.
+    uint8_t getResolutionGain(uint8_t samples) {
+        uint8_t bits = 0;
+        while (samples >= 4) {
+            samples /= 4;
+            bits++;
+        }
+
+        return bits;
+    }
+
+    bool isPending() {
+        return pending;
+    }
+
+    // Entering noise reduction sleep with the ADC idle starts the pending
+    // conversion. Close to a Timer0 overflow it is started right away
+    // instead. Returns the time slept in microseconds.
+    uint16_t sleep() {
+        #ifdef ADC_NOISE_REDUCTION
+            set_sleep_mode(SLEEP_MODE_ADC);
+
+            // Interrupts stay off from the check up to the sleep, sei() only
+            // takes effect after the following instruction.
+            cli();
+            pending = false;
+
+            if (TCNT0 >= TIMER0_SLEEP_LIMIT) {
+                ADCSRA |= _BV(ADSC);
+                sei();
+                return 0;
+            }
+
+            converted = false;
+            sleeping = true;
+
+            sleep_enable();
+            sei();
+            sleep_cpu();
+            sleep_disable();
+
+            sleeping = false;
+
+            // Woken early by some other interrupt the lost time is unknown,
+            // but rare enough to be ignored.
+            if (converted) {
+                ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+                    TCNT0 += CONVERSION_TIMER0_TICKS;
+                }
+
+                return CONVERSION_MICROS;
+            }
+        #endif
+
+        return 0;
+    }
+
+    // Without a steady line interrupt conversions chain from the ADC
+    // interrupt instead, as without ADC_LINE_TRIGGERED. Called from the line
+    // interrupt, a conversion in flight is collected by whichever way is
+    // active once it completes.
+    void setLineTriggered(bool enabled) {
+        #ifdef ADC_LINE_TRIGGERED
+            if (enabled == lineTriggered)
+                return;
+
+            lineTriggered = enabled;
+
+            // ADIF is cleared by writing it as 1, so it's masked out.
+            if (enabled) {
+                ADCSRA &= ~(_BV(ADIE) | _BV(ADIF));
+            } else {
+                ADCSRA = (ADCSRA & ~_BV(ADIF)) | _BV(ADIE);
+
+                if (waiting) {
+                    waiting = false;
+                    ADCSRA |= _BV(ADSC);
+                }
+            }
+        #endif
+    }
+
+    // Called once per scanline from the line interrupt, on lines without
+    // pixel output. Collects the conversion started on the previous line and
+    // starts the next one.
+    void trigger() {
+        #ifdef ADC_LINE_TRIGGERED
+            if (!lineTriggered)
+                return;
+
+            if (ADCSRA & _BV(ADIF)) {
+                ADCSRA |= _BV(ADIF);
+                collect(ADC);
+            }
+
+            if (waiting) {
+                waiting = false;
+                ADCSRA |= _BV(ADSC);
+            }
+        #endif
+    }
+}
+
+
+static inline bool isSlotDue(uint8_t slot) {
+    return static_cast<uint8_t>(rotation) % slots[slot].divider == 0;
+}
+
+static inline void selectSlot(uint8_t slot) {
+    ADMUX = _BV(REFS0) | (slots[slot].channel & 0x07);
+}
+
+// While sleeping in noise reduction mode the conversion is left to the next
+// sleep, otherwise started right away. Line triggered it waits for the next
+// call of trigger().
+static inline void convert() {
+    #ifdef ADC_NOISE_REDUCTION
+        if (sleeping) {
+            pending = true;
+            return;
+        }
+    #endif
+
+    if (isLineTriggered()) {
+        waiting = true;
+    } else {
+        ADCSRA |= _BV(ADSC);
+    }
+}
+
+static inline void collect(const uint16_t value) {
+    if (discardCount > 0) {
+        discardCount--;
+    } else {
+        sampleSum += value;
+        sampleCount++;
+
+        if (sampleCount == slots[currentSlot].samples) {
+            results[currentSlot] = sampleSum;
+            sampleSum = 0;
+            sampleCount = 0;
+
+            do {
+                currentSlot++;
+            } while (currentSlot < slotCount && !isSlotDue(currentSlot));
+
+            if (currentSlot == slotCount) {
+                rotation++;
+                running = false;
+                return;
+            }
+
+            selectSlot(currentSlot);
+            discardCount = 1;
+        }
+    }
+
+    convert();
+}
+
+static inline bool isLineTriggered() {
+    #ifdef ADC_LINE_TRIGGERED
+        return lineTriggered;
+    #else
+        return false;
+    #endif
+}
+
+
+ISR(ADC_vect) {
+    converted = true;
+    collect(ADC);
+}
@@ -0,0 +1,40 @@
+#ifndef ADC_H
+#define ADC_H
+
+
+#include <stdint.h>
+
+
+//
+// Background ADC sampling. Inputs are registered as slots and converted in a
+// rotation driven by the ADC interrupt: the first conversion after switching
+// the multiplexer is dropped and every slot sums several samples, giving
+// extra resolution from the input noise. Slow inputs can be set to only be
+// converted every few rotations.
+//
+// Where possible conversions are started by entering ADC noise reduction
+// sleep, so they run with the CPU and I/O clocks halted. With
+// ADC_LINE_TRIGGERED they are started and collected by calling trigger()
+// instead, at a fixed rate and without the ADC interrupt. While that rate
+// can't be relied on, setLineTriggered(false) goes back to the ADC interrupt.
+//
+namespace Adc {
+    void setup();
+    uint8_t addSlot(uint8_t pin, uint8_t samples, uint8_t divider = 1);
+
+    void start();
+    void restart();
+
+    uint16_t getResult(uint8_t slot);
+    uint16_t getRotation();
+    uint8_t getResolutionGain(uint8_t samples);
+
+    bool isPending();
+    uint16_t sleep();
+
+    void setLineTriggered(bool enabled);
+    void trigger();
+}
+
+
+#endif
@@ -0,0 +1,210 @@
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "settings.h"
+#include "settings_internal.h"
+#include "settings_eeprom.h"
+#include "beeper.h"
+#include "buttons.h"
+#include "timer.h"
+
+
+#define OUTPUT_BUZZER _BV(0)
+#define OUTPUT_LED _BV(1)
+
+// Plays even with beeping disabled in the settings.
+#define FLAG_ALWAYS _BV(7)
+
+#define STEPS_MAX 6
+
+// Steps are in 10ms, alternating on and off, terminated by 0.
+#define STEP(ms) ((ms) / 10)
+
+
+struct PatternDef {
+    uint8_t flags;
+    uint8_t priority;
+    uint8_t repeats;
+    uint8_t steps[STEPS_MAX];
+};
+
+
+// Indexed by Beeper::Pattern.
+static const PatternDef patterns[] PROGMEM = {
+    // CLICK
+    {
+        OUTPUT_BUZZER,
+        1,
+        1,
+        { STEP(BEEPER_CLICK_MSEC), 0 }
+    },
+
+    // LOCK_FOUND
+    {
+        OUTPUT_BUZZER | OUTPUT_LED,
+        2,
+        1,
+        { STEP(100), STEP(50), STEP(200), 0 }
+    },
+
+    // DIVERSITY_SWITCH
+    {
+        OUTPUT_LED,
+        0,
+        1,
+        { STEP(BEEPER_CLICK_MSEC), 0 }
+    },
+
+    #ifdef USE_VOLTAGE_MONITORING
+        // BATTERY_WARNING
+        {
+            OUTPUT_BUZZER | OUTPUT_LED | FLAG_ALWAYS,
+            3,
+            WARNING_BEEPS,
+            {
+                STEP(WARNING_BEEP_EVERY_MSEC / 2),
+                STEP(WARNING_BEEP_EVERY_MSEC / 2),
+                0
+            }
+        },
+
+        // BATTERY_CRITICAL
+        {
+            OUTPUT_BUZZER | OUTPUT_LED | FLAG_ALWAYS,
+            4,
+            CRITICAL_BEEPS,
+            {
+                STEP(CRITICAL_BEEP_EVERY_MSEC / 2),
+                STEP(CRITICAL_BEEP_EVERY_MSEC / 2),
+                0
+            }
+        },
+    #endif
+};
+
+
+#ifdef BEEPER_BUTTON_CLICKS
+    static void onButtonChange(Button button, Buttons::PressType pressType);
+#endif
+static void startNext();
+static void setOutputs(bool on);
+
+
+static Beeper::Pattern queue[BEEPER_QUEUE_MAX];
+static uint8_t queueSize = 0;
+
+static PatternDef current;
+static bool playing = false;
+static uint8_t currentStep = 0;
+static uint8_t repeatsLeft = 0;
+static uint32_t stepStart = 0;
+
+
+namespace Beeper {
+    void setup() {
+        #ifdef BEEPER_BUTTON_CLICKS
+            Buttons::registerChangeFunc(onButtonChange);
+        #endif
+    }
+
+    // Run by the scheduler every TASK_PERIOD_BEEPER ms.
+    void update() {
+        if (!playing) {
+            startNext();
+            return;
+        }
+
+        if (Timer::now - stepStart < current.steps[currentStep] * 10UL)
+            return;
+
+        stepStart += current.steps[currentStep] * 10UL;
+        currentStep++;
+
+        if (currentStep >= STEPS_MAX || current.steps[currentStep] == 0) {
+            if (--repeatsLeft == 0) {
+                setOutputs(false);
+                playing = false;
+                startNext();
+                return;
+            }
+
+            currentStep = 0;
+        }
+
+        setOutputs(currentStep % 2 == 0);
+    }
+
+    // Patterns already queued are not queued again, so bursts of clicks
+    // don't pile up. Drops the pattern if the queue is full.
+    void play(Pattern pattern) {
+        for (uint8_t i = 0; i < queueSize; i++) {
+            if (queue[i] == pattern)
+                return;
+        }
+
+        if (queueSize >= BEEPER_QUEUE_MAX)
+            return;
+
+        queue[queueSize++] = pattern;
+    }
+}
+
+
+#ifdef BEEPER_BUTTON_CLICKS
+static void onButtonChange(Button button, Buttons::PressType pressType) {
+    if (
+        pressType == Buttons::PressType::SHORT ||
+        pressType == Buttons::PressType::HOLDING
+    ) {
+        Beeper::play(Beeper::Pattern::CLICK);
+    }
+}
+#endif
+
+static void startNext() {
+    if (queueSize == 0)
+        return;
+
+    uint8_t next = 0;
+    uint8_t nextPriority = 0;
+    for (uint8_t i = 0; i < queueSize; i++) {
+        const uint8_t priority = pgm_read_byte(
+            &patterns[static_cast<uint8_t>(queue[i])].priority);
+
+        if (i == 0 || priority > nextPriority) {
+            next = i;
+            nextPriority = priority;
+        }
+    }
+
+    memcpy_P(
+        &current,
+        &patterns[static_cast<uint8_t>(queue[next])],
+        sizeof(PatternDef)
+    );
+
+    queueSize--;
+    for (uint8_t i = next; i < queueSize; i++)
+        queue[i] = queue[i + 1];
+
+    if (!EepromSettings.beepEnabled && !(current.flags & FLAG_ALWAYS))
+        current.flags &= ~OUTPUT_BUZZER;
+
+    playing = true;
+    currentStep = 0;
+    repeatsLeft = current.repeats;
+    stepStart = Timer::now;
+
+    setOutputs(true);
+}
+
+// Buzzer is active low, LED active high.
+static void setOutputs(bool on) {
+    if (current.flags & OUTPUT_BUZZER)
+        digitalWrite(PIN_BUZZER, on ? LOW : HIGH);
+
+    if (current.flags & OUTPUT_LED)
+        digitalWrite(PIN_LED, on ? HIGH : LOW);
+}
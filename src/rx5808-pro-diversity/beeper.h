@@ -0,0 +1,34 @@
+#ifndef BEEPER_H
+#define BEEPER_H
+
+
+#include <stdint.h>
+#include "settings.h"
+
+
+//
+// Plays on/off patterns on the buzzer and LED without blocking. Patterns are
+// queued and the one with the highest priority is played next, a playing
+// pattern is never cut short.
+//
+namespace Beeper {
+    enum class Pattern : uint8_t {
+        CLICK,
+        LOCK_FOUND,
+        DIVERSITY_SWITCH
+        #ifdef USE_VOLTAGE_MONITORING
+            ,
+            BATTERY_WARNING,
+            BATTERY_CRITICAL
+        #endif
+    };
+
+
+    void setup();
+    void update();
+
+    void play(Pattern pattern);
+}
+
+
+#endif
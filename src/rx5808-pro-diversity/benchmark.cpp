@@ -0,0 +1,117 @@
+#include <Arduino.h>
+#include <stdint.h>
+
+#include "settings.h"
+
+#ifdef USE_BENCHMARK
+
+#include "benchmark.h"
+#include "state.h"
+#include "ui.h"
+#include "twi.h"
+
+
+struct Stats {
+    uint16_t count;
+    uint16_t max;
+    uint32_t total;
+};
+
+
+static Stats drawStats[STATE_COUNT];
+static Stats flushStats;
+static Stats frameStats;
+
+
+static void record(Stats &stats, uint32_t time);
+static void print(Stats &stats);
+static uint16_t getFreeRam();
+
+
+namespace Benchmark {
+    void recordDraw(uint8_t state, uint32_t time) {
+        record(drawStats[state], time);
+    }
+
+    void recordFlush(uint32_t time, bool fullFrame) {
+        record(fullFrame ? frameStats : flushStats, time);
+    }
+
+    void update() {
+        for (uint8_t i = 0; i < STATE_COUNT; i++) {
+            if (drawStats[i].count == 0)
+                continue;
+
+            Serial.print(F("draw "));
+            Serial.print(i);
+            Serial.print(F(": "));
+            print(drawStats[i]);
+        }
+
+        if (frameStats.count > 0) {
+            Serial.print(F("flush frame: "));
+            print(frameStats);
+        }
+
+        if (flushStats.count > 0) {
+            Serial.print(F("flush columns: "));
+            print(flushStats);
+        }
+
+        #ifdef OLED_FAST_TWI
+            Serial.print(F("twi: "));
+            Serial.print(Twi::getClock());
+            Serial.println(F("Hz"));
+        #endif
+
+        Serial.print(F("ram: "));
+        Serial.print(getFreeRam());
+        Serial.println(F(" bytes free"));
+
+        #ifdef TVOUT_SCREENS
+            Serial.print(F("tv: "));
+            Serial.print(Ui::display.getLineCycles());
+            Serial.print(F(" cycles per rendered line, "));
+            Serial.print(Ui::display.getRenderLoad());
+            Serial.println(F("% of frame"));
+        #endif
+    }
+}
+
+
+static void record(Stats &stats, uint32_t time) {
+    stats.count++;
+    stats.total += time;
+    if (time > stats.max)
+        stats.max = min(time, UINT16_MAX);
+}
+
+// Averages are also given in CPU cycles, and reset after printing.
+static void print(Stats &stats) {
+    const uint32_t average = stats.total / stats.count;
+
+    Serial.print(stats.count);
+    Serial.print(F(" frames, avg "));
+    Serial.print(average);
+    Serial.print(F("us ("));
+    Serial.print(average * clockCyclesPerMicrosecond());
+    Serial.print(F(" cycles), max "));
+    Serial.print(stats.max);
+    Serial.println(F("us"));
+
+    stats.count = 0;
+    stats.max = 0;
+    stats.total = 0;
+}
+
+// Gap between the top of the heap (or the end of the static data if nothing
+// was allocated) and the stack, as deep as the stack currently is.
+static uint16_t getFreeRam() {
+    extern char __heap_start;
+    extern char *__brkval;
+
+    char top;
+    return &top - (__brkval != nullptr ? __brkval : &__heap_start);
+}
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+
+#include <stdint.h>
+#include "settings.h"
+
+
+#ifdef USE_BENCHMARK
+
+//
+// Collects how long every screen takes to draw a frame and how long display
+// flushes take, whole frames and column windows apart. Printed to serial
+// every TASK_PERIOD_BENCHMARK ms together with the free RAM. With OLED_PAGED
+// the draw time is the whole frame, all pages drawn and sent.
+//
+namespace Benchmark {
+    void recordDraw(uint8_t state, uint32_t time);
+    void recordFlush(uint32_t time, bool fullFrame);
+
+    void update();
+}
+
+#endif
+
+
+#endif
@@ -1,40 +1,114 @@
 #include <Arduino.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
 #include <stdint.h>
 
 #include "buttons.h"
 #include "settings.h"
+#include "timer.h"
+
+
+//
+// Pin changes are captured by the pin change interrupt together with a
+// timestamp and queued. update() then debounces and classifies presses from
+// the queued timestamps, so press durations no longer depend on how long the
+// loop takes.
+//
+struct ButtonEvent {
+    uint8_t readings;
+    unsigned long time;
+};
+
+
+static const Buttons::RepeatConfig defaultRepeat = {
+    BUTTON_REPEAT_DELAY,
+    BUTTON_REPEAT_RATE,
+    BUTTON_REPEAT_ACCELERATION,
+    BUTTON_REPEAT_RATE_MIN
+};
 
 
 struct Buttons::ButtonState states[BUTTON_COUNT];
+static const Buttons::RepeatConfig *repeatConfigs[BUTTON_COUNT] = {
+    &defaultRepeat,
+    &defaultRepeat,
+    &defaultRepeat,
+    &defaultRepeat
+};
 static Buttons::ChangeFunc changeFuncs[BUTTON_HOOKS_MAX] = { nullptr };
 
+static const uint8_t pins[BUTTON_COUNT] = {
+    PIN_BUTTON_UP,
+    PIN_BUTTON_DOWN,
+    PIN_BUTTON_MODE,
+    PIN_BUTTON_SAVE
+};
+static volatile uint8_t *pinRegisters[BUTTON_COUNT];
+static uint8_t pinMasks[BUTTON_COUNT];
+
+static ButtonEvent events[BUTTON_EVENTS_MAX];
+static volatile uint8_t eventHead = 0;
+static volatile uint8_t eventTail = 0;
+static uint8_t lastReadings = 0;
+
+
+static void captureReadings();
+
 
 namespace Buttons {
     static void runChangeFuncs(Button button, PressType pressType);
+    static bool popEvent(ButtonEvent &event);
     static void updateButton(
         const Button button,
         struct Buttons::ButtonState &state,
-        const uint8_t pin
+        const RepeatConfig &repeat,
+        const unsigned long now
     );
 
 
     uint32_t lastChangeTime = 0;
 
 
+    void setup() {
+        for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+            pinRegisters[i] = portInputRegister(digitalPinToPort(pins[i]));
+            pinMasks[i] = digitalPinToBitMask(pins[i]);
+
+            *digitalPinToPCMSK(pins[i]) |= _BV(digitalPinToPCMSKbit(pins[i]));
+            *digitalPinToPCICR(pins[i]) |= _BV(digitalPinToPCICRbit(pins[i]));
+        }
+
+        // Pick up buttons already held at boot.
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            captureReadings();
+        }
+    }
+
     void update() {
-        #define UPDATE_BUTTON(button) \
-            updateButton( \
-                Button::button, \
-                states[static_cast<size_t>(Button::button)], \
-                PIN_BUTTON_ ## button \
-            );
+        // Events may be stamped after the tick was taken, hence the signed
+        // comparisons below.
+        const unsigned long now = Timer::now;
 
-        UPDATE_BUTTON(UP);
-        UPDATE_BUTTON(DOWN);
-        UPDATE_BUTTON(MODE);
-        UPDATE_BUTTON(SAVE);
+        ButtonEvent event;
+        while (popEvent(event)) {
+            for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+                const bool reading = event.readings & _BV(i);
 
-        #undef UPDATE_BUTTON
+                if (reading != states[i].lastReading) {
+                    states[i].lastReading = reading;
+                    states[i].lastDebounceTime = event.time;
+                }
+            }
+        }
+
+        for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+            updateButton(
+                static_cast<Button>(i),
+                states[i],
+                *repeatConfigs[i],
+                now
+            );
+        }
     }
 
     const ButtonState *get(Button button) {
@@ -50,6 +124,13 @@ namespace Buttons {
         return false;
     }
 
+    // Passing nullptr restores the default repeat behaviour. Takes effect on
+    // the next press, the config must outlive its use.
+    void setRepeat(Button button, const RepeatConfig *config) {
+        repeatConfigs[static_cast<size_t>(button)] =
+            config != nullptr ? config : &defaultRepeat;
+    }
+
     void registerChangeFunc(ChangeFunc func) {
         for (uint8_t i = 0; i < BUTTON_HOOKS_MAX; i++) {
             if (changeFuncs[i] == nullptr) {
@@ -76,44 +157,129 @@ namespace Buttons {
         }
     }
 
-    static void updateButton(
-        const Button button,
-        struct ButtonState &state,
-        const uint8_t pin
-    ) {
-        const uint8_t reading = !digitalRead(pin); // Invert as we use pull-ups.
+    static bool popEvent(ButtonEvent &event) {
+        bool popped = false;
 
-        if (reading != state.lastReading) {
-            state.lastDebounceTime = millis();
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            if (eventTail != eventHead) {
+                event = events[eventTail];
+                eventTail = (eventTail + 1) % BUTTON_EVENTS_MAX;
+                popped = true;
+            }
         }
 
-        state.lastReading = reading;
+        return popped;
+    }
 
+    static void updateButton(
+        const Button button,
+        struct ButtonState &state,
+        const RepeatConfig &repeat,
+        const unsigned long now
+    ) {
         if (
-            reading != state.pressed &&
-            (millis() - state.lastDebounceTime) >= BUTTON_DEBOUNCE_DELAY
+            state.lastReading != state.pressed &&
+            static_cast<long>(now - state.lastDebounceTime) >=
+                BUTTON_DEBOUNCE_DELAY
         ) {
-            state.pressed = reading;
+            state.pressed = state.lastReading;
 
+            // Time from the edge itself rather than from when we got to it.
             uint32_t prevChangeTime = state.changeTime;
-            state.changeTime = millis();
-            lastChangeTime = state.changeTime;
+            state.changeTime = state.lastDebounceTime;
+            lastChangeTime = now;
 
-            if (!state.pressed) {
+            if (state.pressed) {
+                state.nextRepeatTime = state.changeTime + repeat.delay;
+                state.repeatRate = repeat.rate;
+            } else if (state.holding) {
+                state.holding = false;
+                runChangeFuncs(button, PressType::HOLDING_END);
+            } else {
                 uint32_t duration = state.changeTime - prevChangeTime;
 
-                if (duration < 500)
+                if (duration < 500) {
                     runChangeFuncs(button, PressType::SHORT);
-                else if (duration < 2000)
+
+                    #ifdef BUTTON_DOUBLE_CLICK_DELAY
+                        if (
+                            state.clickPending &&
+                            prevChangeTime - state.clickTime <
+                                BUTTON_DOUBLE_CLICK_DELAY
+                        ) {
+                            state.clickPending = false;
+                            runChangeFuncs(button, PressType::DOUBLE);
+                        } else {
+                            state.clickPending = true;
+                            state.clickTime = state.changeTime;
+                        }
+                    #endif
+                } else {
                     runChangeFuncs(button, PressType::LONG);
+                }
             }
         }
 
-        if (state.pressed) {
-            uint32_t duration = millis() - state.changeTime;
+        if (
+            state.pressed &&
+            static_cast<long>(now - state.nextRepeatTime) >= 0
+        ) {
+            state.holding = true;
+            runChangeFuncs(button, PressType::HOLDING);
 
-            if (duration >= 2000)
-                runChangeFuncs(button, PressType::HOLDING);
+            // Scheduled from the previous repeat rather than from now, so
+            // the rate holds even if the loop was late.
+            state.nextRepeatTime += state.repeatRate;
+            if (static_cast<long>(now - state.nextRepeatTime) >= 0)
+                state.nextRepeatTime = now + state.repeatRate;
+
+            if (state.repeatRate >= repeat.rateMin + repeat.acceleration) {
+                state.repeatRate -= repeat.acceleration;
+            } else {
+                state.repeatRate = repeat.rateMin;
+            }
         }
     }
 }
+
+
+static void captureReadings() {
+    uint8_t readings = 0;
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        if (!(*pinRegisters[i] & pinMasks[i])) // Invert as we use pull-ups.
+            readings |= _BV(i);
+    }
+
+    if (readings == lastReadings)
+        return;
+
+    lastReadings = readings;
+
+    const uint8_t next = (eventHead + 1) % BUTTON_EVENTS_MAX;
+    if (next == eventTail) {
+        // Queue is full, fold into the newest event so the final state wins.
+        const uint8_t newest =
+            (eventHead + BUTTON_EVENTS_MAX - 1) % BUTTON_EVENTS_MAX;
+        events[newest].readings = readings;
+        events[newest].time = millis();
+        return;
+    }
+
+    events[eventHead].readings = readings;
+    events[eventHead].time = millis();
+    eventHead = next;
+}
+
+
+// Buttons may sit on any port, only the vectors enabled in setup() will fire.
+ISR(PCINT0_vect) {
+    captureReadings();
+}
+
+ISR(PCINT1_vect) {
+    captureReadings();
+}
+
+ISR(PCINT2_vect) {
+    captureReadings();
+}
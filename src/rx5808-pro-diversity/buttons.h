@@ -4,8 +4,11 @@
 
 #include <stdint.h>
 
+#include "settings.h"
+
 
 #define BUTTON_HOOKS_MAX 4
+#define BUTTON_EVENTS_MAX 8
 
 
 enum class Button : uint8_t {
@@ -22,7 +25,21 @@ namespace Buttons {
     enum class PressType : uint8_t {
         SHORT,
         LONG,
-        HOLDING
+        HOLDING,
+        HOLDING_END,
+        #ifdef BUTTON_DOUBLE_CLICK_DELAY
+            DOUBLE
+        #endif
+    };
+
+
+    // Controls when HOLDING is reported and repeated while a button is held.
+    // Rates are in milliseconds between repeats.
+    struct RepeatConfig {
+        uint16_t delay;
+        uint16_t rate;
+        uint16_t acceleration;
+        uint16_t rateMin;
     };
 
 
@@ -32,6 +49,15 @@ namespace Buttons {
 
         bool pressed = false;
         unsigned long changeTime = 0;
+
+        bool holding = false;
+        unsigned long nextRepeatTime = 0;
+        uint16_t repeatRate = 0;
+
+        #ifdef BUTTON_DOUBLE_CLICK_DELAY
+            bool clickPending = false;
+            unsigned long clickTime = 0;
+        #endif
     };
 
 
@@ -40,11 +66,14 @@ namespace Buttons {
 
     extern uint32_t lastChangeTime;
 
+    void setup();
     void update();
 
     const ButtonState *get(Button button);
     const bool any();
 
+    void setRepeat(Button button, const RepeatConfig *config);
+
     void registerChangeFunc(ChangeFunc func);
     void deregisterChangeFunc(ChangeFunc func);
 }
@@ -0,0 +1,192 @@
+#include "settings.h"
+#include "settings_internal.h"
+
+#ifdef OLED_PAGED
+
+#include <string.h>
+#include <Wire.h>
+#include <avr/pgmspace.h>
+
+#include "display_paged.h"
+#include "twi.h"
+
+
+// Same setup as Adafruit_SSD1306::begin() for a 128x64 panel, the charge
+// pump, contrast and precharge follow from the VCC source.
+static const uint8_t initCommands[] PROGMEM = {
+    SSD1306_DISPLAYOFF,
+    SSD1306_SETDISPLAYCLOCKDIV, 0x80,
+    SSD1306_SETMULTIPLEX, PAGED_HEIGHT - 1,
+    SSD1306_SETDISPLAYOFFSET, 0x00,
+    SSD1306_SETSTARTLINE | 0x00,
+    SSD1306_MEMORYMODE, 0x00,
+    SSD1306_SEGREMAP | 0x01,
+    SSD1306_COMSCANDEC,
+    SSD1306_SETCOMPINS, 0x12,
+    SSD1306_SETVCOMDETECT, 0x40,
+    SSD1306_DISPLAYALLON_RESUME,
+    SSD1306_NORMALDISPLAY,
+    SSD1306_DEACTIVATE_SCROLL
+};
+
+
+PagedDisplay::PagedDisplay() : Adafruit_GFX(PAGED_WIDTH, PAGED_HEIGHT) {
+}
+
+bool PagedDisplay::begin(uint8_t vccState, uint8_t address) {
+    this->vccState = vccState;
+    this->address = address;
+
+    Wire.begin();
+
+    for (uint8_t i = 0; i < sizeof(initCommands); i++)
+        command(pgm_read_byte(&initCommands[i]));
+
+    const bool external = vccState == SSD1306_EXTERNALVCC;
+
+    command(SSD1306_CHARGEPUMP);
+    command(external ? 0x10 : 0x14);
+    command(SSD1306_SETCONTRAST);
+    command(external ? 0x9F : 0xCF);
+    command(SSD1306_SETPRECHARGE);
+    command(external ? 0x22 : 0xF1);
+
+    command(SSD1306_DISPLAYON);
+
+    clearDisplay();
+    return true;
+}
+
+void PagedDisplay::dim(bool dim) {
+    command(SSD1306_SETCONTRAST);
+    if (dim) {
+        command(0);
+    } else {
+        command(vccState == SSD1306_EXTERNALVCC ? 0x9F : 0xCF);
+    }
+}
+
+void PagedDisplay::clearDisplay() {
+    memset(buffer, 0, PAGED_WIDTH);
+}
+
+void PagedDisplay::setPage(uint8_t page) {
+    this->page = page;
+    clearDisplay();
+}
+
+void PagedDisplay::flushPage() {
+    #ifdef OLED_FAST_TWI
+        const uint8_t window[] = {
+            SSD1306_COLUMNADDR, 0, PAGED_WIDTH - 1,
+            SSD1306_PAGEADDR, page, page
+        };
+
+        Twi::write(0x00, window, sizeof(window));
+        Twi::write(0x40, buffer, PAGED_WIDTH);
+    #else
+        command(SSD1306_COLUMNADDR);
+        command(0);
+        command(PAGED_WIDTH - 1);
+        command(SSD1306_PAGEADDR);
+        command(page);
+        command(page);
+
+        // Keep within the 32 byte Wire buffer.
+        for (uint8_t x = 0; x < PAGED_WIDTH; x += 16) {
+            Wire.beginTransmission(address);
+            Wire.write(0x40);
+            Wire.write(buffer + x, 16);
+            Wire.endTransmission();
+        }
+    #endif
+}
+
+void PagedDisplay::command(uint8_t c) {
+    Wire.beginTransmission(address);
+    Wire.write(0x00);
+    Wire.write(c);
+    Wire.endTransmission();
+}
+
+
+// Bits of the current page covered by rows y to y + h, 0 if none are.
+static inline uint8_t pageBits(
+    const uint8_t page,
+    const int16_t y,
+    const int16_t h
+) {
+    const int16_t top = page * 8;
+    const int16_t y0 = max(y, top);
+    const int16_t y1 = min(y + h, top + 8);
+    if (y0 >= y1)
+        return 0;
+
+    return (0xFF << (y0 - top)) & (0xFF >> (top + 8 - y1));
+}
+
+void PagedDisplay::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || x >= PAGED_WIDTH || (y >> 3) != page || y < 0)
+        return;
+
+    fillColumns(x, 1, 1 << (y & 7), color);
+}
+
+void PagedDisplay::drawFastHLine(
+    int16_t x,
+    int16_t y,
+    int16_t w,
+    uint16_t color
+) {
+    if ((y >> 3) != page || y < 0)
+        return;
+
+    fillColumns(x, w, 1 << (y & 7), color);
+}
+
+void PagedDisplay::drawFastVLine(
+    int16_t x,
+    int16_t y,
+    int16_t h,
+    uint16_t color
+) {
+    fillColumns(x, 1, pageBits(page, y, h), color);
+}
+
+void PagedDisplay::fillRect(
+    int16_t x,
+    int16_t y,
+    int16_t w,
+    int16_t h,
+    uint16_t color
+) {
+    fillColumns(x, w, pageBits(page, y, h), color);
+}
+
+void PagedDisplay::fillScreen(uint16_t color) {
+    fillColumns(0, PAGED_WIDTH, 0xFF, color);
+}
+
+// Applies the same bits to columns x to x + w of the page.
+void PagedDisplay::fillColumns(
+    int16_t x,
+    int16_t w,
+    const uint8_t bits,
+    const uint16_t color
+) {
+    const int16_t x0 = max(x, 0);
+    const int16_t x1 = min(x + w, PAGED_WIDTH);
+    if (bits == 0 || x0 >= x1)
+        return;
+
+    uint8_t *dst = buffer + x0;
+    for (uint8_t i = x1 - x0; i > 0; i--, dst++) {
+        switch (color) {
+            case WHITE: *dst |= bits; break;
+            case BLACK: *dst &= ~bits; break;
+            case INVERSE: *dst ^= bits; break;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef DISPLAY_PAGED_H
+#define DISPLAY_PAGED_H
+
+
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include <stdint.h>
+
+#include "settings.h"
+#include "settings_internal.h"
+
+
+#define PAGED_WIDTH 128
+#define PAGED_HEIGHT 64
+#define PAGED_PAGES (PAGED_HEIGHT / 8)
+
+
+//
+// SSD1306 backend holding a single 8 pixel high page instead of the whole
+// framebuffer. A frame is drawn once per page: setPage() clears the buffer,
+// everything outside the page is clipped away and flushPage() sends the page
+// to the display. The picture loop itself is in StateMachine::draw().
+//
+class PagedDisplay : public Adafruit_GFX {
+    public:
+        PagedDisplay();
+
+        bool begin(
+            uint8_t vccState = SSD1306_SWITCHCAPVCC,
+            uint8_t address = 0x3C
+        );
+        void display() {};
+        void dim(bool dim);
+        void clearDisplay();
+
+        void setPage(uint8_t page);
+        uint8_t getPage() { return page; };
+        void flushPage();
+
+        void drawPixel(int16_t x, int16_t y, uint16_t color);
+        void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+        void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+        void fillRect(
+            int16_t x,
+            int16_t y,
+            int16_t w,
+            int16_t h,
+            uint16_t color
+        );
+        void fillScreen(uint16_t color);
+
+    private:
+        uint8_t buffer[PAGED_WIDTH];
+        uint8_t page = 0;
+        uint8_t address = 0x3C;
+        uint8_t vccState = SSD1306_SWITCHCAPVCC;
+
+        void command(uint8_t c);
+        void fillColumns(
+            int16_t x,
+            int16_t w,
+            const uint8_t bits,
+            const uint16_t color
+        );
+};
+
+
+#endif
@@ -0,0 +1,168 @@
+#include "settings.h"
+#include "settings_internal.h"
+
+#ifdef SH1106
+
+#include <string.h>
+#include <Wire.h>
+#include <avr/pgmspace.h>
+
+#include "display_sh1106.h"
+#include "twi.h"
+
+
+// The 128 columns of the panel start at column 2 of the controller RAM.
+#define SH1106_COLUMN_OFFSET 2
+
+#define SH1106_SETLOWCOLUMN 0x00
+#define SH1106_SETHIGHCOLUMN 0x10
+#define SH1106_SETSTARTLINE 0x40
+#define SH1106_SETCONTRAST 0x81
+#define SH1106_SEGREMAP 0xA0
+#define SH1106_DISPLAYALLON_RESUME 0xA4
+#define SH1106_NORMALDISPLAY 0xA6
+#define SH1106_SETMULTIPLEX 0xA8
+#define SH1106_DCDC 0xAD
+#define SH1106_DISPLAYOFF 0xAE
+#define SH1106_DISPLAYON 0xAF
+#define SH1106_SETPAGE 0xB0
+#define SH1106_COMSCANDEC 0xC8
+#define SH1106_SETDISPLAYOFFSET 0xD3
+#define SH1106_SETDISPLAYCLOCKDIV 0xD5
+#define SH1106_SETPRECHARGE 0xD9
+#define SH1106_SETCOMPINS 0xDA
+#define SH1106_SETVCOMDETECT 0xDB
+
+// Control bytes: a single command followed by another control byte, or data
+// up to the end of the transaction.
+#define SH1106_CONTROL_COMMAND 0x80
+#define SH1106_CONTROL_DATA 0x40
+
+
+static const uint8_t initCommands[] PROGMEM = {
+    SH1106_DISPLAYOFF,
+    SH1106_SETDISPLAYCLOCKDIV, 0x80,
+    SH1106_SETMULTIPLEX, SH1106_HEIGHT - 1,
+    SH1106_SETDISPLAYOFFSET, 0x00,
+    SH1106_SETSTARTLINE | 0x00,
+    SH1106_SEGREMAP | 0x01,
+    SH1106_COMSCANDEC,
+    SH1106_SETCOMPINS, 0x12,
+    SH1106_SETVCOMDETECT, 0x40,
+    SH1106_DISPLAYALLON_RESUME,
+    SH1106_NORMALDISPLAY
+};
+
+
+Sh1106Display::Sh1106Display() : Adafruit_GFX(SH1106_WIDTH, SH1106_HEIGHT) {
+}
+
+// The DC-DC converter takes the place of the SSD1306 charge pump.
+bool Sh1106Display::begin(uint8_t vccState, uint8_t address) {
+    this->vccState = vccState;
+    this->address = address;
+
+    Wire.begin();
+
+    for (uint8_t i = 0; i < sizeof(initCommands); i++)
+        command(pgm_read_byte(&initCommands[i]));
+
+    const bool external = vccState == SH1106_EXTERNALVCC;
+
+    command(SH1106_DCDC);
+    command(external ? 0x8A : 0x8B);
+    command(SH1106_SETCONTRAST);
+    command(external ? 0x9F : 0xCF);
+    command(SH1106_SETPRECHARGE);
+    command(external ? 0x22 : 0xF1);
+
+    command(SH1106_DISPLAYON);
+
+    return true;
+}
+
+void Sh1106Display::display() {
+    display(0, SH1106_WIDTH, 0xFF);
+}
+
+// Sends columns start to end of every page set in the pages mask.
+void Sh1106Display::display(uint8_t start, uint8_t end, uint8_t pages) {
+    for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+        if (pages & (1 << page))
+            sendPage(page, start, end);
+    }
+}
+
+void Sh1106Display::dim(bool dim) {
+    command(SH1106_SETCONTRAST);
+    if (dim) {
+        command(0);
+    } else {
+        command(vccState == SH1106_EXTERNALVCC ? 0x9F : 0xCF);
+    }
+}
+
+void Sh1106Display::clearDisplay() {
+    memset(buffer, 0, sizeof(buffer));
+}
+
+void Sh1106Display::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || x >= SH1106_WIDTH || y < 0 || y >= SH1106_HEIGHT)
+        return;
+
+    uint8_t *dst = buffer + (y >> 3) * SH1106_WIDTH + x;
+    const uint8_t bit = 1 << (y & 7);
+
+    switch (color) {
+        case WHITE: *dst |= bit; break;
+        case BLACK: *dst &= ~bit; break;
+        case INVERSE: *dst ^= bit; break;
+    }
+}
+
+void Sh1106Display::command(uint8_t c) {
+    Wire.beginTransmission(address);
+    Wire.write(0x00);
+    Wire.write(c);
+    Wire.endTransmission();
+}
+
+// Page and column address are three commands, which go out in front of the
+// data within the same transaction where possible.
+void Sh1106Display::sendPage(uint8_t page, uint8_t start, uint8_t end) {
+    const uint8_t column = start + SH1106_COLUMN_OFFSET;
+    const uint8_t setPage = SH1106_SETPAGE | page;
+    const uint8_t setLow = SH1106_SETLOWCOLUMN | (column & 0x0F);
+    const uint8_t setHigh = SH1106_SETHIGHCOLUMN | (column >> 4);
+    const uint8_t *src = buffer + page * SH1106_WIDTH + start;
+
+    #ifdef OLED_FAST_TWI
+        const uint8_t header[] = {
+            SH1106_CONTROL_COMMAND, setPage,
+            SH1106_CONTROL_COMMAND, setLow,
+            SH1106_CONTROL_COMMAND, setHigh,
+            SH1106_CONTROL_DATA
+        };
+
+        Twi::write(header, sizeof(header), src, end - start);
+    #else
+        Wire.beginTransmission(address);
+        Wire.write(0x00);
+        Wire.write(setPage);
+        Wire.write(setLow);
+        Wire.write(setHigh);
+        Wire.endTransmission();
+
+        // Keep within the 32 byte Wire buffer.
+        for (uint8_t x = start; x < end; x += 16) {
+            Wire.beginTransmission(address);
+            Wire.write(SH1106_CONTROL_DATA);
+            Wire.write(src, min(end - x, 16));
+            Wire.endTransmission();
+
+            src += 16;
+        }
+    #endif
+}
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef DISPLAY_SH1106_H
+#define DISPLAY_SH1106_H
+
+
+#include <Adafruit_GFX.h>
+#include <stdint.h>
+
+#include "settings.h"
+#include "settings_internal.h"
+
+
+#ifndef WHITE
+    #define BLACK 0
+    #define WHITE 1
+    #define INVERSE 2
+#endif
+
+#define SH1106_EXTERNALVCC 0x1
+#define SH1106_SWITCHCAPVCC 0x2
+
+
+#define SH1106_WIDTH 128
+#define SH1106_HEIGHT 64
+#define SH1106_PAGES (SH1106_HEIGHT / 8)
+
+
+//
+// SH1106 backend with the same buffer layout as the SSD1306, so Ui can draw
+// into it directly. The controller only has page addressing and 132 columns
+// of RAM with the panel centered in them. Every page sent needs its own page
+// and column address, which display() only does for the pages asked for.
+//
+class Sh1106Display : public Adafruit_GFX {
+    public:
+        Sh1106Display();
+
+        bool begin(
+            uint8_t vccState = SH1106_SWITCHCAPVCC,
+            uint8_t address = 0x3C
+        );
+        void display();
+        void display(uint8_t start, uint8_t end, uint8_t pages);
+        void dim(bool dim);
+        void clearDisplay();
+
+        uint8_t *getBuffer() { return buffer; };
+
+        void drawPixel(int16_t x, int16_t y, uint16_t color);
+
+    private:
+        uint8_t buffer[SH1106_WIDTH * SH1106_PAGES];
+        uint8_t address = 0x3C;
+        uint8_t vccState = SH1106_SWITCHCAPVCC;
+
+        void command(uint8_t c);
+        void sendPage(uint8_t page, uint8_t start, uint8_t end);
+};
+
+
+#endif
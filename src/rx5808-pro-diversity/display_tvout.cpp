@@ -0,0 +1,398 @@
+#include "settings.h"
+#include "settings_internal.h"
+
+#ifdef TVOUT_SCREENS
+
+#include <string.h>
+
+#include "display_tvout.h"
+#include "adc.h"
+#include <TVout.h>
+
+
+#ifdef ENABLE_USART_OUTPUT
+    #if \
+        PIN_BUTTON_UP == 4 || \
+        PIN_BUTTON_DOWN == 4 || \
+        PIN_BUTTON_MODE == 4 || \
+        PIN_BUTTON_SAVE == 4
+        #error "TVout USART output drives pin 4, move the button elsewhere."
+    #endif
+    #if defined(USE_SERIAL_OUT) || defined(USE_BENCHMARK)
+        #error "TVout USART output can't be used together with serial."
+    #endif
+#endif
+
+
+// Same resolution as the OLEDs, TVout scales the lines up to fill the screen.
+// The OSD is a strip of its own height instead.
+#define TV_WIDTH 128
+#ifdef TVOUT_OSD
+    #define TV_HEIGHT OSD_HEIGHT
+#else
+    #define TV_HEIGHT 64
+#endif
+#define TV_ROW_BYTES (TV_WIDTH / 8)
+
+// Estimated cost of the line interrupt itself, entry and exit, the hbi hook
+// and the line handler bookkeeping.
+#define TV_ISR_CYCLES 100
+
+#ifdef TVOUT_NTSC
+    #define TV_MODE NTSC
+#else
+    #define TV_MODE PAL
+#endif
+
+
+static TVout tv;
+
+
+static void onScanline();
+
+
+TvoutDisplay::TvoutDisplay() : Adafruit_GFX(TV_WIDTH, TV_HEIGHT) {
+}
+
+// Ui::setup() calls this twice, the framebuffer must only be allocated once.
+bool TvoutDisplay::begin() {
+    if (buffer != nullptr)
+        return true;
+
+    if (tv.begin(TV_MODE, TV_WIDTH, TV_HEIGHT) != 0)
+        return false;
+
+    buffer = tv.screen;
+
+    #ifdef ADC_LINE_TRIGGERED
+        tv.set_hbi_hook(onScanline);
+    #endif
+
+    // Scaled while still on the internal clock, forcing waits for a frame
+    // which never comes without video input. Switching the clock centers
+    // the picture again, so the start line is set directly afterwards.
+    #ifdef TVOUT_OSD
+        tv.force_vscale(OSD_VSCALE);
+        tv.video_clock(CLOCK_EXTERN);
+        ::display.start_render = OSD_LINE_START;
+    #endif
+
+    return true;
+}
+
+// Rendered lines wait for the output start and then shift out every pixel
+// within the interrupt, all other lines only cost the interrupt itself.
+// ::display is the timing state of TVout, not our display() member.
+// With USART output the last two bytes shift out after the interrupt ended.
+uint16_t TvoutDisplay::getLineCycles() {
+    #ifdef ENABLE_USART_OUTPUT
+        const uint8_t renderedBytes = ::display.hres - 2;
+    #else
+        const uint8_t renderedBytes = ::display.hres;
+    #endif
+
+    return
+        ::display.output_delay +
+        renderedBytes * 8 * render_cycles_per_pixel +
+        TV_ISR_CYCLES;
+}
+
+// Without captured sync there is no picture to disturb, and lines come far
+// too slowly to wait for.
+void TvoutDisplay::waitForBlanking(const uint8_t lines) {
+    const int renderStart = ::display.start_render;
+    const int renderEnd =
+        renderStart + ::display.vres * (::display.vscale_const + 1);
+
+    while (true) {
+        #ifdef TVOUT_OSD
+            if (!line_captured)
+                return;
+        #endif
+
+        // Read twice as the line interrupt may change it in between bytes.
+        int line;
+        do {
+            line = ::display.scanLine;
+        } while (line != ::display.scanLine);
+
+        if (line >= renderEnd || line < renderStart - lines)
+            return;
+    }
+}
+
+uint8_t TvoutDisplay::getRenderLoad() {
+    const uint32_t scanlineCycles = ::display.video_mode ?
+        _PAL_CYCLES_SCANLINE + 1 : _NTSC_CYCLES_SCANLINE + 1;
+    const uint16_t renderedLines =
+        ::display.vres * (::display.vscale_const + 1);
+    const uint16_t otherLines = ::display.lines_frame - renderedLines;
+
+    const uint32_t used =
+        static_cast<uint32_t>(renderedLines) * getLineCycles() +
+        static_cast<uint32_t>(otherLines) * TV_ISR_CYCLES;
+
+    return used * 100 / (::display.lines_frame * scanlineCycles);
+}
+
+void TvoutDisplay::clearDisplay() {
+    memset(buffer, 0, TV_ROW_BYTES * TV_HEIGHT);
+}
+
+
+// The TVout framebuffer is row major with the leftmost pixel in the MSB.
+static inline void plot(uint8_t *dst, const uint8_t mask, const uint16_t color) {
+    switch (color) {
+        case WHITE: *dst |= mask; break;
+        case BLACK: *dst &= ~mask; break;
+        case INVERSE: *dst ^= mask; break;
+    }
+}
+
+void TvoutDisplay::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || x >= TV_WIDTH || y < 0 || y >= TV_HEIGHT)
+        return;
+
+    plot(buffer + y * TV_ROW_BYTES + (x >> 3), 0x80 >> (x & 7), color);
+}
+
+#ifdef TVOUT_FAST_DRAW
+
+void TvoutDisplay::drawFastHLine(
+    int16_t x,
+    int16_t y,
+    int16_t w,
+    uint16_t color
+) {
+    if (y < 0 || y >= TV_HEIGHT)
+        return;
+
+    const int16_t x0 = max(x, 0);
+    const int16_t x1 = min(x + w, TV_WIDTH);
+    if (x0 >= x1)
+        return;
+
+    fillSpan(buffer + y * TV_ROW_BYTES, x0, x1, color);
+}
+
+void TvoutDisplay::drawFastVLine(
+    int16_t x,
+    int16_t y,
+    int16_t h,
+    uint16_t color
+) {
+    if (x < 0 || x >= TV_WIDTH)
+        return;
+
+    const int16_t y0 = max(y, 0);
+    const int16_t y1 = min(y + h, TV_HEIGHT);
+    if (y0 >= y1)
+        return;
+
+    uint8_t *dst = buffer + y0 * TV_ROW_BYTES + (x >> 3);
+    const uint8_t mask = 0x80 >> (x & 7);
+
+    for (uint8_t i = y1 - y0; i > 0; i--, dst += TV_ROW_BYTES)
+        plot(dst, mask, color);
+}
+
+void TvoutDisplay::fillRect(
+    int16_t x,
+    int16_t y,
+    int16_t w,
+    int16_t h,
+    uint16_t color
+) {
+    const int16_t x0 = max(x, 0);
+    const int16_t x1 = min(x + w, TV_WIDTH);
+    const int16_t y0 = max(y, 0);
+    const int16_t y1 = min(y + h, TV_HEIGHT);
+    if (x0 >= x1 || y0 >= y1)
+        return;
+
+    uint8_t *row = buffer + y0 * TV_ROW_BYTES;
+    for (uint8_t i = y1 - y0; i > 0; i--, row += TV_ROW_BYTES)
+        fillSpan(row, x0, x1, color);
+}
+
+void TvoutDisplay::fillScreen(uint16_t color) {
+    if (color == INVERSE) {
+        for (uint16_t i = 0; i < TV_ROW_BYTES * TV_HEIGHT; i++)
+            buffer[i] ^= 0xFF;
+    } else {
+        memset(buffer, color == WHITE ? 0xFF : 0x00, TV_ROW_BYTES * TV_HEIGHT);
+    }
+}
+
+// Bresenham stepping a byte pointer and bit mask instead of coordinates, so
+// no row offset is multiplied per pixel. Lines leaving the screen are left
+// to GFX, which clips per pixel.
+void TvoutDisplay::drawLine(
+    int16_t x0,
+    int16_t y0,
+    int16_t x1,
+    int16_t y1,
+    uint16_t color
+) {
+    if (
+        x0 < 0 || x0 >= TV_WIDTH || x1 < 0 || x1 >= TV_WIDTH ||
+        y0 < 0 || y0 >= TV_HEIGHT || y1 < 0 || y1 >= TV_HEIGHT
+    ) {
+        Adafruit_GFX::drawLine(x0, y0, x1, y1, color);
+        return;
+    }
+
+    if (x0 > x1) {
+        int16_t t = x0; x0 = x1; x1 = t;
+        t = y0; y0 = y1; y1 = t;
+    }
+
+    const uint8_t dx = x1 - x0;
+    const uint8_t dy = abs(y1 - y0);
+    const int8_t rowStep = y0 < y1 ? TV_ROW_BYTES : -TV_ROW_BYTES;
+
+    uint8_t *dst = buffer + y0 * TV_ROW_BYTES + (x0 >> 3);
+    uint8_t mask = 0x80 >> (x0 & 7);
+
+    if (dx >= dy) {
+        int16_t error = dx / 2;
+        for (uint8_t i = dx + 1; i > 0; i--) {
+            plot(dst, mask, color);
+
+            mask >>= 1;
+            if (mask == 0) {
+                mask = 0x80;
+                dst++;
+            }
+
+            error -= dy;
+            if (error < 0) {
+                dst += rowStep;
+                error += dx;
+            }
+        }
+    } else {
+        int16_t error = dy / 2;
+        for (uint8_t i = dy + 1; i > 0; i--) {
+            plot(dst, mask, color);
+            dst += rowStep;
+
+            error -= dx;
+            if (error < 0) {
+                mask >>= 1;
+                if (mask == 0) {
+                    mask = 0x80;
+                    dst++;
+                }
+
+                error += dy;
+            }
+        }
+    }
+}
+
+#endif
+
+// Moves columns x + distance to x + w left by distance, within rows y to
+// y + h. Every destination byte is taken out of a 16 bit window over the
+// source, reading ahead of what was written so it works in place. The
+// columns uncovered on the right are left as they were.
+void TvoutDisplay::scrollLeft(
+    int16_t x,
+    int16_t y,
+    int16_t w,
+    int16_t h,
+    uint8_t distance
+) {
+    const int16_t x0 = max(x, 0);
+    const int16_t x1 = min(x + w, TV_WIDTH) - distance;
+    const int16_t y0 = max(y, 0);
+    const int16_t y1 = min(y + h, TV_HEIGHT);
+    if (x0 >= x1 || y0 >= y1)
+        return;
+
+    const uint8_t byteShift = distance >> 3;
+    const uint8_t bitShift = distance & 7;
+    const uint8_t firstByte = x0 >> 3;
+    const uint8_t lastByte = (x1 - 1) >> 3;
+    const uint8_t firstMask = 0xFF >> (x0 & 7);
+    const uint8_t lastMask = 0xFF << (7 - ((x1 - 1) & 7));
+
+    uint8_t *row = buffer + y0 * TV_ROW_BYTES;
+    for (uint8_t i = y1 - y0; i > 0; i--, row += TV_ROW_BYTES) {
+        for (uint8_t b = firstByte; b <= lastByte; b++) {
+            const uint8_t src = b + byteShift;
+            const uint16_t window =
+                (row[src] << 8) |
+                (src + 1 < TV_ROW_BYTES ? row[src + 1] : 0);
+            const uint8_t value = (window << bitShift) >> 8;
+
+            uint8_t mask = 0xFF;
+            if (b == firstByte)
+                mask &= firstMask;
+            if (b == lastByte)
+                mask &= lastMask;
+
+            row[b] = (row[b] & ~mask) | (value & mask);
+        }
+    }
+}
+
+// Fills columns x0 to x1 of a row, masking the partial bytes at both ends.
+void TvoutDisplay::fillSpan(
+    uint8_t *row,
+    const uint8_t x0,
+    const uint8_t x1,
+    const uint16_t color
+) {
+    const uint8_t firstByte = x0 >> 3;
+    const uint8_t lastByte = (x1 - 1) >> 3;
+    const uint8_t firstMask = 0xFF >> (x0 & 7);
+    const uint8_t lastMask = 0xFF << (7 - ((x1 - 1) & 7));
+
+    if (firstByte == lastByte) {
+        plot(row + firstByte, firstMask & lastMask, color);
+        return;
+    }
+
+    plot(row + firstByte, firstMask, color);
+    plot(row + lastByte, lastMask, color);
+
+    const uint8_t middle = lastByte - firstByte - 1;
+    if (color == INVERSE) {
+        for (uint8_t b = firstByte + 1; b < lastByte; b++)
+            row[b] ^= 0xFF;
+    } else {
+        memset(row + firstByte + 1, color == WHITE ? 0xFF : 0x00, middle);
+    }
+}
+
+
+#ifdef ADC_LINE_TRIGGERED
+    // Runs at the start of every line, before the line handler. Conversions
+    // are only started and collected on lines without pixel output. A
+    // conversion started right before the rendered lines is collected after
+    // them.
+    //
+    // Without sync, as on any channel without video, OSD lines only come
+    // from Timer1 overflowing every 4ms. The ADC interrupt takes over then.
+    static void onScanline() {
+        #ifdef TVOUT_OSD
+            Adc::setLineTriggered(line_captured);
+            if (!line_captured)
+                return;
+        #endif
+
+        const int line = ::display.scanLine;
+        const int renderStart = ::display.start_render;
+        const int renderEnd =
+            renderStart + ::display.vres * (::display.vscale_const + 1);
+
+        if (line >= renderStart && line < renderEnd)
+            return;
+
+        Adc::trigger();
+    }
+#endif
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef DISPLAY_TVOUT_H
+#define DISPLAY_TVOUT_H
+
+
+#include <Adafruit_GFX.h>
+#include <stdint.h>
+
+#include "settings.h"
+#include "settings_internal.h"
+
+
+#ifndef WHITE
+    #define BLACK 0
+    #define WHITE 1
+    #define INVERSE 2
+#endif
+
+
+//
+// TVout backend with the same interface Ui uses from the OLED classes, so
+// Ui::display is simply of this type when building for TV out. TVout keeps
+// rendering from its framebuffer on its own, display() has nothing to do.
+//
+// With TVOUT_OSD it is only a strip of OSD_HEIGHT lines, genlocked to the
+// sync of the received video.
+//
+// TVout.h itself is only included in the implementation, its UP/DOWN and
+// colour macros would clash with our own names.
+//
+class TvoutDisplay : public Adafruit_GFX {
+    public:
+        TvoutDisplay();
+
+        bool begin();
+        void display() {};
+        void dim(bool dim) {};
+        void clearDisplay();
+
+        uint8_t *getBuffer() { return buffer; };
+
+        // Interrupt cycles per rendered scanline, and the share of all cycles
+        // the interrupt takes over a frame in percent.
+        uint16_t getLineCycles();
+        uint8_t getRenderLoad();
+
+        // Returns once at least lines scanlines are left before the rendered
+        // lines are scanned again, so drawing can't be seen half done.
+        void waitForBlanking(const uint8_t lines);
+
+        void drawPixel(int16_t x, int16_t y, uint16_t color);
+
+        #ifdef TVOUT_FAST_DRAW
+            void drawFastHLine(
+                int16_t x,
+                int16_t y,
+                int16_t w,
+                uint16_t color
+            );
+            void drawFastVLine(
+                int16_t x,
+                int16_t y,
+                int16_t h,
+                uint16_t color
+            );
+            void fillRect(
+                int16_t x,
+                int16_t y,
+                int16_t w,
+                int16_t h,
+                uint16_t color
+            );
+            void fillScreen(uint16_t color);
+            void drawLine(
+                int16_t x0,
+                int16_t y0,
+                int16_t x1,
+                int16_t y1,
+                uint16_t color
+            );
+        #endif
+
+        void scrollLeft(
+            int16_t x,
+            int16_t y,
+            int16_t w,
+            int16_t h,
+            uint8_t distance
+        );
+
+    private:
+        uint8_t *buffer = nullptr;
+
+        void fillSpan(
+            uint8_t *row,
+            const uint8_t x0,
+            const uint8_t x1,
+            const uint16_t color
+        );
+};
+
+
+#endif
@@ -0,0 +1,77 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdint.h>
+
+#include "eeprom_writer.h"
+
+
+struct Job {
+    uint16_t address;
+    const uint8_t *data;
+    uint8_t size;
+};
+
+
+static Job jobs[EEPROM_WRITER_JOBS_MAX];
+static volatile uint8_t jobCount = 0;
+static volatile uint8_t jobIndex = 0;
+
+
+namespace EepromWriter {
+    bool queue(uint16_t address, const uint8_t *data, uint8_t size) {
+        if (isBusy() || jobCount >= EEPROM_WRITER_JOBS_MAX)
+            return false;
+
+        jobs[jobCount].address = address;
+        jobs[jobCount].data = data;
+        jobs[jobCount].size = size;
+        jobCount++;
+
+        return true;
+    }
+
+    void start() {
+        if (jobCount == 0)
+            return;
+
+        jobIndex = 0;
+
+        // Fires straight away if no write is in progress.
+        EECR |= _BV(EERIE);
+    }
+
+    bool isBusy() {
+        return EECR & _BV(EERIE);
+    }
+}
+
+
+ISR(EE_READY_vect) {
+    while (jobIndex < jobCount) {
+        Job &job = jobs[jobIndex];
+
+        while (job.size) {
+            const uint8_t value = *job.data;
+
+            EEAR = job.address;
+            EECR |= _BV(EERE);
+
+            job.address++;
+            job.data++;
+            job.size--;
+
+            // Unchanged bytes are skipped, saving the cell a write cycle.
+            if (EEDR != value) {
+                EEDR = value;
+                EECR |= _BV(EEMPE);
+                EECR |= _BV(EEPE);
+                return;
+            }
+        }
+
+        jobIndex++;
+    }
+
+    jobCount = 0;
+    EECR &= ~_BV(EERIE);
+}
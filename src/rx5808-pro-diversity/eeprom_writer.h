@@ -0,0 +1,27 @@
+#ifndef EEPROM_WRITER_H
+#define EEPROM_WRITER_H
+
+
+#include <stdint.h>
+
+
+#define EEPROM_WRITER_JOBS_MAX 2
+
+
+//
+// Background EEPROM writer. Queued byte ranges are written one byte per
+// EE_READY interrupt, so programming a byte (~3.3ms) never blocks the loop.
+//
+// Jobs are written strictly in the order they were queued, which callers can
+// rely on to write a commit marker last. Source data must stay untouched until
+// isBusy() returns false, and no other EEPROM access may happen meanwhile.
+//
+namespace EepromWriter {
+    bool queue(uint16_t address, const uint8_t *data, uint8_t size);
+    void start();
+
+    bool isBusy();
+}
+
+
+#endif
@@ -0,0 +1,166 @@
+#include <stdint.h>
+
+#include "settings.h"
+
+#ifdef TVOUT_OSD
+
+#include "osd.h"
+#include "receiver.h"
+#include "channels.h"
+#include "ui.h"
+
+
+//
+// Strip of OSD_HEIGHT lines laid over the received video. Black pixels are
+// not driven and let the video through, so everything is drawn in white.
+//
+#define CHANNEL_TEXT_X 0
+#define CHANNEL_TEXT_Y 0
+#define FREQUENCY_TEXT_X 0
+#define FREQUENCY_TEXT_Y (CHAR_HEIGHT + 1)
+
+#define RX_TEXT_X 32
+#define RX_TEXT_A_Y 0
+#define RX_TEXT_B_Y (CHAR_HEIGHT + 1)
+
+#define BAR_X (RX_TEXT_X + CHAR_WIDTH + 3)
+#define BAR_W (SCREEN_WIDTH - BAR_X)
+#define BAR_H (CHAR_HEIGHT - 1)
+
+#define CHANNEL_TEXT_W (4 * (CHAR_WIDTH + 1))
+
+// Scanlines needed to redraw the strip, with ample spare for interrupts.
+#define OSD_DRAW_LINES 64
+
+
+struct BarState {
+    uint8_t w;
+    bool active;
+};
+
+
+static void drawChannel();
+static void drawRssiBar(
+    const char *label,
+    const uint8_t y,
+    const BarState &state
+);
+static BarState getBarState(const uint8_t rssi, const bool active);
+static inline bool isBarChanged(const uint8_t index, const BarState &state);
+
+
+static uint8_t drawnChannel = 0xFF;
+static BarState drawnBars[2] = { { 0xFF, false }, { 0xFF, false } };
+
+
+namespace Osd {
+    // Only fields which changed are drawn, each over its old contents, and
+    // never while the strip is scanned out.
+    void update() {
+        const bool channelChanged = Receiver::activeChannel != drawnChannel;
+
+        #ifdef USE_DIVERSITY
+            const BarState bars[2] = {
+                getBarState(
+                    Receiver::rssiA,
+                    Receiver::activeReceiver == Receiver::ReceiverId::A
+                ),
+                getBarState(
+                    Receiver::rssiB,
+                    Receiver::activeReceiver == Receiver::ReceiverId::B
+                )
+            };
+            const uint8_t barCount = 2;
+        #else
+            const BarState bars[1] = {
+                getBarState(Receiver::rssiA, true)
+            };
+            const uint8_t barCount = 1;
+        #endif
+
+        bool barsChanged = false;
+        for (uint8_t i = 0; i < barCount; i++)
+            barsChanged |= isBarChanged(i, bars[i]);
+
+        if (!channelChanged && !barsChanged)
+            return;
+
+        Ui::display.waitForBlanking(OSD_DRAW_LINES);
+
+        if (channelChanged)
+            drawChannel();
+
+        const char *labels[] = { "A", "B" };
+        const uint8_t ys[] = { RX_TEXT_A_Y, RX_TEXT_B_Y };
+        for (uint8_t i = 0; i < barCount; i++) {
+            if (isBarChanged(i, bars[i])) {
+                drawRssiBar(labels[i], ys[i], bars[i]);
+                drawnBars[i] = bars[i];
+            }
+        }
+    }
+}
+
+
+static void drawChannel() {
+    drawnChannel = Receiver::activeChannel;
+
+    Ui::clearRect(
+        CHANNEL_TEXT_X,
+        CHANNEL_TEXT_Y,
+        CHANNEL_TEXT_W,
+        FREQUENCY_TEXT_Y + CHAR_HEIGHT
+    );
+
+    Ui::drawText(
+        CHANNEL_TEXT_X,
+        CHANNEL_TEXT_Y,
+        Channels::getName(drawnChannel),
+        1
+    );
+
+    Ui::drawNumber(
+        FREQUENCY_TEXT_X,
+        FREQUENCY_TEXT_Y,
+        Channels::getFrequency(drawnChannel),
+        1
+    );
+}
+
+// The label of the active receiver is drawn inverted. The bar is filled up
+// to its width and cleared after it.
+static void drawRssiBar(
+    const char *label,
+    const uint8_t y,
+    const BarState &state
+) {
+    const uint16_t labelColor = state.active ? WHITE : BLACK;
+
+    Ui::fillRect(
+        RX_TEXT_X - 1,
+        y,
+        CHAR_WIDTH + 2,
+        CHAR_HEIGHT,
+        labelColor
+    );
+    Ui::drawText(RX_TEXT_X, y, label, 1, state.active ? BLACK : WHITE);
+
+    Ui::fillRect(BAR_X, y, state.w, BAR_H, WHITE);
+    Ui::clearRect(BAR_X + state.w, y, BAR_W - state.w, BAR_H);
+}
+
+static BarState getBarState(const uint8_t rssi, const bool active) {
+    BarState state;
+    state.w = min(rssi, 100) * BAR_W / 100;
+    state.active = active;
+
+    return state;
+}
+
+static inline bool isBarChanged(const uint8_t index, const BarState &state) {
+    return
+        state.w != drawnBars[index].w ||
+        state.active != drawnBars[index].active;
+}
+
+#endif
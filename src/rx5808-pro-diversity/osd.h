@@ -0,0 +1,10 @@
+#ifndef OSD_H
+#define OSD_H
+
+
+namespace Osd {
+    void update();
+}
+
+
+#endif
@@ -0,0 +1,70 @@
+#include <Arduino.h>
+#include <avr/sleep.h>
+#include <stdint.h>
+
+#include "power.h"
+#include "settings.h"
+#include "settings_internal.h"
+#include "ui.h"
+#include "adc.h"
+
+
+static uint32_t windowStart = 0;
+static uint32_t sleepTime = 0;
+static uint8_t load = 100;
+
+
+namespace Power {
+    // Any interrupt wakes us up again: the millis() timer overflow at the
+    // latest, but also pin changes, EEPROM ready or the ADC. With an ADC
+    // conversion pending we sleep in noise reduction mode instead.
+    void idle() {
+        if (Adc::isPending()) {
+            sleepTime += Adc::sleep();
+            return;
+        }
+
+        const uint32_t sleepStart = micros();
+
+        set_sleep_mode(SLEEP_MODE_IDLE);
+        sleep_mode();
+
+        sleepTime += micros() - sleepStart;
+    }
+
+    // Run by the scheduler every TASK_PERIOD_POWER ms.
+    void update() {
+        const uint32_t now = micros();
+        const uint32_t elapsed = now - windowStart;
+
+        if (sleepTime >= elapsed) {
+            load = 0;
+        } else {
+            load = 100 - sleepTime / (elapsed / 100);
+        }
+
+        windowStart = now;
+        sleepTime = 0;
+    }
+
+    // Percentage of the last window the MCU was awake.
+    uint8_t getLoad() {
+        return load;
+    }
+
+    // Estimated current draw in 0.1mA.
+    uint16_t getCurrent() {
+        uint16_t current = POWER_CURRENT_BASE;
+
+        current += POWER_CURRENT_MCU_IDLE +
+            static_cast<uint32_t>(
+                POWER_CURRENT_MCU_ACTIVE - POWER_CURRENT_MCU_IDLE
+            ) * load / 100;
+
+        current += Ui::isDimmed
+            ? POWER_CURRENT_DISPLAY_DIMMED
+            : POWER_CURRENT_DISPLAY;
+
+        return current;
+    }
+}
@@ -0,0 +1,23 @@
+#ifndef POWER_H
+#define POWER_H
+
+
+#include <stdint.h>
+
+
+//
+// Puts the MCU to sleep whenever the scheduler has nothing to do and keeps
+// track of how long it was awake. The awake share and a few calibrated
+// constants (see settings_internal.h) give an estimate of the current draw,
+// shown on the settings screen.
+//
+namespace Power {
+    void idle();
+    void update();
+
+    uint8_t getLoad();
+    uint16_t getCurrent();
+}
+
+
+#endif
@@ -6,6 +6,8 @@
 #include "receiver.h"
 #include "receiver_spi.h"
 #include "channels.h"
+#include "adc.h"
+#include "beeper.h"
 
 #include "timer.h"
 
@@ -17,6 +19,8 @@ namespace Receiver {
     ReceiverId activeReceiver = ReceiverId::A;
     uint8_t activeChannel = 0;
 
+    uint8_t rssiLastCount = 0;
+
     uint8_t rssiA = 0;
     uint16_t rssiARaw = 0;
     uint8_t rssiALast[RECEIVER_LAST_DATA_SIZE] = { 0 };
@@ -30,6 +34,14 @@ namespace Receiver {
     #endif
 
     static Timer rssiStableTimer = Timer(MIN_TUNE_TIME);
+    static bool rssiStable = false;
+    static bool rssiWaitingForRotation = false;
+    static uint16_t rssiRotation = 0;
+
+    static uint8_t rssiSlotA;
+    #ifdef USE_DIVERSITY
+        static uint8_t rssiSlotB;
+    #endif
     static Timer rssiLogTimer = Timer(RECEIVER_LAST_DELAY);
     #ifdef USE_SERIAL_OUT
         static Timer serialLogTimer = Timer(25);
@@ -41,6 +53,8 @@ namespace Receiver {
         ReceiverSpi::setSynthRegisterB(Channels::getSynthRegisterB(channel));
 
         rssiStableTimer.reset();
+        rssiStable = false;
+        rssiWaitingForRotation = false;
         activeChannel = channel;
     }
 
@@ -73,23 +87,26 @@ namespace Receiver {
         activeReceiver = receiver;
     }
 
+    // Stable once a full ADC rotation was started after the tune time.
     bool isRssiStable() {
-        return rssiStableTimer.hasTicked();
+        return rssiStable;
     }
 
+    // Maps the oversampled sums rather than the raw values, so the
+    // percentages keep the extra resolution.
     uint16_t updateRssi() {
-        analogRead(PIN_RSSI_A); // Fake read to let ADC settle.
-        rssiARaw = analogRead(PIN_RSSI_A);
+        const uint16_t rssiASum = Adc::getResult(rssiSlotA);
+        rssiARaw = rssiASum / ADC_RSSI_SAMPLES;
         #ifdef USE_DIVERSITY
-            analogRead(PIN_RSSI_B);
-            rssiBRaw = analogRead(PIN_RSSI_B);
+            const uint16_t rssiBSum = Adc::getResult(rssiSlotB);
+            rssiBRaw = rssiBSum / ADC_RSSI_SAMPLES;
         #endif
 
         rssiA = constrain(
             map(
-                rssiARaw,
-                EepromSettings.rssiAMin,
-                EepromSettings.rssiAMax,
+                rssiASum,
+                EepromSettings.rssiAMin * ADC_RSSI_SAMPLES,
+                EepromSettings.rssiAMax * ADC_RSSI_SAMPLES,
                 0,
                 100
             ),
@@ -99,9 +116,9 @@ namespace Receiver {
         #ifdef USE_DIVERSITY
             rssiB = constrain(
                 map(
-                    rssiBRaw,
-                    EepromSettings.rssiBMin,
-                    EepromSettings.rssiBMax,
+                    rssiBSum,
+                    EepromSettings.rssiBMin * ADC_RSSI_SAMPLES,
+                    EepromSettings.rssiBMax * ADC_RSSI_SAMPLES,
                     0,
                     100
                 ),
@@ -123,6 +140,7 @@ namespace Receiver {
                 rssiBLast[RECEIVER_LAST_DATA_SIZE - 1] = rssiB;
             #endif
 
+            rssiLastCount++;
             rssiLogTimer.reset();
         }
     }
@@ -173,7 +191,10 @@ namespace Receiver {
             }
         }
 
-        setActiveReceiver(nextReceiver);
+        if (nextReceiver != activeReceiver) {
+            setActiveReceiver(nextReceiver);
+            Beeper::play(Beeper::Pattern::DIVERSITY_SWITCH);
+        }
     }
 #endif
 
@@ -181,38 +202,66 @@ namespace Receiver {
         #ifdef DISABLE_AUDIO
             ReceiverSpi::setPowerDownRegister(0b00010000110111110011);
         #endif
+
+        rssiSlotA = Adc::addSlot(PIN_RSSI_A, ADC_RSSI_SAMPLES);
+        #ifdef USE_DIVERSITY
+            rssiSlotB = Adc::addSlot(PIN_RSSI_B, ADC_RSSI_SAMPLES);
+        #endif
     }
 
     void update() {
-        if (rssiStableTimer.hasTicked()) {
-            updateRssi();
+        Adc::start();
+
+        if (!rssiStableTimer.hasTicked())
+            return;
+
+        // Samples from before the module settled must not be used, throw
+        // away the rotation in progress and wait for a fresh one.
+        if (!rssiStable) {
+            if (!rssiWaitingForRotation) {
+                Adc::restart();
+                rssiRotation = Adc::getRotation();
+                rssiWaitingForRotation = true;
+                return;
+            }
 
-            #ifdef USE_SERIAL_OUT
-                writeSerialData();
-            #endif
+            if (Adc::getRotation() == rssiRotation)
+                return;
 
-            #ifdef USE_DIVERSITY
-                switchDiversity();
-            #endif
+            rssiStable = true;
+            rssiWaitingForRotation = false;
         }
+
+        const uint16_t rotation = Adc::getRotation();
+        if (rotation == rssiRotation)
+            return;
+
+        rssiRotation = rotation;
+        updateRssi();
+
+        #ifdef USE_SERIAL_OUT
+            writeSerialData();
+        #endif
+
+        #ifdef USE_DIVERSITY
+            switchDiversity();
+        #endif
     }
 }
 
 
 #ifdef USE_SERIAL_OUT
 
-#include "pstr_helper.h"
-
 static void writeSerialData() {
     if (Receiver::serialLogTimer.hasTicked()) {
         Serial.print(Receiver::activeChannel, DEC);
-        Serial.print(PSTR2("\t"));
+        Serial.print(F("\t"));
         Serial.print(Receiver::rssiA, DEC);
-        Serial.print(PSTR2("\t"));
+        Serial.print(F("\t"));
         Serial.print(Receiver::rssiARaw, DEC);
-        Serial.print(PSTR2("\t"));
+        Serial.print(F("\t"));
         Serial.print(Receiver::rssiB, DEC);
-        Serial.print(PSTR2("\t"));
+        Serial.print(F("\t"));
         Serial.println(Receiver::rssiBRaw, DEC);
 
         Receiver::serialLogTimer.reset();
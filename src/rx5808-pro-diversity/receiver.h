@@ -31,6 +31,8 @@ namespace Receiver {
     extern ReceiverId activeReceiver;
     extern uint8_t activeChannel;
 
+    extern uint8_t rssiLastCount; // Incremented with every logged sample.
+
     extern uint8_t rssiA;
     extern uint16_t rssiARaw;
     extern uint8_t rssiALast[RECEIVER_LAST_DATA_SIZE];
@@ -40,8 +40,16 @@ SOFTWARE.
 #include "channels.h"
 #include "receiver.h"
 #include "receiver_spi.h"
+#include "adc.h"
+#include "voltage.h"
+#include "beeper.h"
+#include "benchmark.h"
 #include "buttons.h"
 #include "state.h"
+#include "scheduler.h"
+#include "power.h"
+#include "timer.h"
+#include "osd.h"
 
 #include "ui.h"
 
@@ -50,11 +58,15 @@ static void globalMenuButtonHandler(
     Button button,
     Buttons::PressType pressType
 );
+static void setupTasks();
+static void updateEeprom();
+static void updateScreensaver();
 
 
 void setup()
 {
     setupPins();
+    Timer::tick();
 
     // Enable buzzer and LED for duration of setup process.
     digitalWrite(PIN_LED, HIGH);
@@ -63,7 +75,12 @@ void setup()
     setupSettings();
 
     StateMachine::setup();
+    Buttons::setup();
+    Adc::setup();
     Receiver::setup();
+    #ifdef USE_VOLTAGE_MONITORING
+        Voltage::setup();
+    #endif
     Ui::setup();
 
     Receiver::setActiveReceiver(Receiver::ReceiverId::A);
@@ -71,7 +88,7 @@ void setup()
     #ifdef USE_IR_EMITTER
         Serial.begin(9600);
     #endif
-    #ifdef USE_SERIAL_OUT
+    #if defined(USE_SERIAL_OUT) || defined(USE_BENCHMARK)
         Serial.begin(250000);
     #endif
 
@@ -80,9 +97,12 @@ void setup()
     digitalWrite(PIN_BUZZER, HIGH);
 
     Buttons::registerChangeFunc(globalMenuButtonHandler);
+    Beeper::setup();
 
     // Switch to initial state.
     StateMachine::switchState(StateMachine::State::SEARCH);
+
+    setupTasks();
 }
 
 void setupPins() {
@@ -118,24 +138,52 @@ void setupSettings() {
 }
 
 
+static void setupTasks() {
+    Scheduler::addTask(Receiver::update, TASK_PERIOD_RECEIVER, 0);
+    Scheduler::addTask(Buttons::update, TASK_PERIOD_BUTTONS, 1);
+    Scheduler::addTask(StateMachine::update, TASK_PERIOD_STATE, 2);
+    #ifdef TVOUT_OSD
+        Scheduler::addTask(Osd::update, TASK_PERIOD_DRAW, 3);
+    #else
+        Scheduler::addTask(StateMachine::draw, TASK_PERIOD_DRAW, 3);
+    #endif
+    // Paged frames are sent out by StateMachine::draw() as they are drawn.
+    #ifndef OLED_PAGED
+        Scheduler::addTask(Ui::update, TASK_PERIOD_UI, 4);
+    #endif
+    Scheduler::addTask(updateEeprom, TASK_PERIOD_EEPROM, 5);
+    Scheduler::addTask(updateScreensaver, TASK_PERIOD_SCREENSAVER, 6);
+    Scheduler::addTask(Power::update, TASK_PERIOD_POWER, 7);
+    Scheduler::addTask(Beeper::update, TASK_PERIOD_BEEPER, 8);
+    #ifdef USE_VOLTAGE_MONITORING
+        Scheduler::addTask(Voltage::update, TASK_PERIOD_VOLTAGE, 9);
+    #endif
+    #ifdef USE_BENCHMARK
+        Scheduler::addTask(Benchmark::update, TASK_PERIOD_BENCHMARK, 10);
+    #endif
+}
+
+
 void loop() {
-    Receiver::update();
-    Buttons::update();
-    StateMachine::update();
-    Ui::update();
+    Scheduler::run();
+}
+
+
+static void updateEeprom() {
     EepromSettings.update();
+}
 
+static void updateScreensaver() {
     if (
         StateMachine::currentState != StateMachine::State::SCREENSAVER
         && StateMachine::currentState != StateMachine::State::BANDSCAN
-        && (millis() - Buttons::lastChangeTime) >
+        && (Timer::now - Buttons::lastChangeTime) >
             (SCREENSAVER_TIMEOUT * 1000)
     ) {
         StateMachine::switchState(StateMachine::State::SCREENSAVER);
     }
 }
 
-
 static void globalMenuButtonHandler(
     Button button,
     Buttons::PressType pressType
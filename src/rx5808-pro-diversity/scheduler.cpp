@@ -0,0 +1,88 @@
+#include <Arduino.h>
+#include <stdint.h>
+
+#include "scheduler.h"
+#include "timer.h"
+#include "power.h"
+
+
+// Deadlines are kept as 16 bit milliseconds and compared with serial number
+// arithmetic, so they wrap safely as long as periods stay below 32 seconds.
+#define DEADLINE_PASSED(now, deadline) \
+    (static_cast<int16_t>((now) - (deadline)) >= 0)
+#define DEADLINE_BEFORE(a, b) (static_cast<int16_t>((a) - (b)) < 0)
+
+
+static Scheduler::Task tasks[SCHEDULER_TASKS_MAX];
+static uint8_t taskCount = 0;
+
+
+namespace Scheduler {
+    static Task *getNextTask(uint16_t now);
+
+
+    void addTask(TaskFunc func, uint16_t period, uint8_t priority) {
+        if (taskCount >= SCHEDULER_TASKS_MAX)
+            return;
+
+        Task &task = tasks[taskCount++];
+        task.func = func;
+        task.period = period;
+        task.priority = priority;
+        task.nextRun = millis();
+        task.overruns = 0;
+    }
+
+    void run() {
+        Timer::tick();
+        const uint16_t now = Timer::now;
+
+        Task *task = getNextTask(now);
+        if (task == nullptr) {
+            Power::idle();
+            return;
+        }
+
+        task->func();
+
+        // Keep the phase unless a whole period was missed, then start over
+        // rather than running the task back to back to catch up.
+        task->nextRun += task->period;
+        if (DEADLINE_PASSED(now, task->nextRun)) {
+            task->overruns++;
+            task->nextRun = now + task->period;
+        }
+    }
+
+    uint8_t getTaskCount() {
+        return taskCount;
+    }
+
+    const Task *getTask(uint8_t index) {
+        return &tasks[index];
+    }
+
+    static Task *getNextTask(uint16_t now) {
+        Task *next = nullptr;
+
+        for (uint8_t i = 0; i < taskCount; i++) {
+            Task *task = &tasks[i];
+
+            if (!DEADLINE_PASSED(now, task->nextRun))
+                continue;
+
+            if (
+                next == nullptr ||
+                DEADLINE_BEFORE(task->nextRun, next->nextRun) ||
+                (
+                    task->nextRun == next->nextRun &&
+                    task->priority < next->priority
+                )
+            ) {
+                next = task;
+            }
+        }
+
+        return next;
+    }
+}
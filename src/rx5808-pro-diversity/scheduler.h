@@ -0,0 +1,39 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+
+#include <stdint.h>
+
+
+#define SCHEDULER_TASKS_MAX 12
+
+
+//
+// Small cooperative scheduler. Every task runs at a fixed period (ms). When
+// several tasks are due, the one with the earliest deadline runs first, ties
+// go to the lowest priority value. If nothing is due the MCU idles until the
+// next interrupt.
+//
+namespace Scheduler {
+    typedef void(*TaskFunc)();
+
+    struct Task {
+        TaskFunc func;
+        uint16_t period;
+        uint16_t nextRun;
+        uint8_t priority;
+
+        // Times the task started a full period or more after its deadline.
+        uint16_t overruns;
+    };
+
+
+    void addTask(TaskFunc func, uint16_t period, uint8_t priority);
+    void run();
+
+    uint8_t getTaskCount();
+    const Task *getTask(uint8_t index);
+}
+
+
+#endif
@@ -30,20 +30,45 @@ SOFTWARE.
 
 // === Display Module ==========================================================
 //
-// You can choose one display module only. Only 128x64 OLED displays are
-// supported.
+// You can choose one display module only. 128x64 OLED displays and composite
+// video through TVout are supported. TVout needs the sync signal on pin 9 and
+// the video signal on pin 7. Video can also be shifted out by the USART on
+// pin 1, which frees up CPU time, see ENABLE_USART_OUTPUT in TVout's
+// spec/hardware_setup.h.
 //
 // =============================================================================
 
-// SSH1106 needs https://github.com/badzz/Adafruit_SH1106 installed.
+// SH1106 is driven by our own code, sending only the pages that changed.
 //#define SH1106
 
 //#define TVOUT_SCREENS
+//#define TVOUT_NTSC // PAL is used otherwise.
+
+// Overlay channel and RSSI on the received video instead of showing the full
+// screens on TV out. Needs the composite sync of the video from a sync
+// separator (LM1881) on pin 8, the video pin is mixed into the video signal.
+//#define TVOUT_OSD
 #define OLED_128x64_ADAFRUIT_SCREENS
 
 // Enable this if your screen is upside down.
 //#define USE_FLIP_SCREEN
 
+// Keep a single 128 byte page of the SSD1306 in RAM instead of the whole 1KB
+// framebuffer. Every screen is then drawn once per page, 8 times a frame,
+// which costs CPU time and makes the fast buffer drawing paths unavailable.
+//#define OLED_PAGED
+
+// Send frames to the SSD1306 in a single I2C transaction each instead of
+// Wire's 32 byte chunks, at up to OLED_TWI_CLOCK. Falls back to 400kHz if the
+// display doesn't keep up. Short wires help at the higher clocks.
+//#define OLED_FAST_TWI
+#define OLED_TWI_CLOCK 800000
+
+// Let the SSD1306 scroll the screensaver ticker itself, only the uncovered
+// columns are sent. Needs a controller with the content scroll commands
+// (2Ch/2Dh), which some older modules lack.
+//#define OLED_HW_SCROLL
+
 #ifdef OLED_128x64_ADAFRUIT_SCREENS
     #define OLED_ADDRESS 0x3C // I2C address for display (0x3C or 0x3D, usually)
 #endif
@@ -88,6 +113,12 @@ SOFTWARE.
 //#define USE_IR_EMITTER
 //#define USE_SERIAL_OUT // Not compatible with IR emitter.
 
+// Prints draw and flush times of every screen to serial every few seconds.
+// Enable BENCHMARK_GFX_ONLY as well to compare against drawing everything
+// through Adafruit GFX.
+//#define USE_BENCHMARK
+//#define BENCHMARK_GFX_ONLY
+
 // You can use any of the arduino analog pins to measure the voltage of the
 // battery. See additional configuration below.
 //#define USE_VOLTAGE_MONITORING
@@ -211,4 +242,26 @@ SOFTWARE.
 // Time needed to hold mode to get to menu
 #define BUTTON_WAIT_FOR_MENU 1000
 
+// Holding a button reports HOLDING after BUTTON_REPEAT_DELAY ms, repeated
+// every BUTTON_REPEAT_RATE ms. Every repeat gets faster by
+// BUTTON_REPEAT_ACCELERATION ms until BUTTON_REPEAT_RATE_MIN is reached.
+#define BUTTON_REPEAT_DELAY 2000
+#define BUTTON_REPEAT_RATE 200
+#define BUTTON_REPEAT_ACCELERATION 20
+#define BUTTON_REPEAT_RATE_MIN 40
+
+// Repeat settings for stepping through channels with UP/DOWN in manual
+// search mode.
+#define SEARCH_REPEAT_DELAY 400
+#define SEARCH_REPEAT_RATE 150
+#define SEARCH_REPEAT_ACCELERATION 10
+#define SEARCH_REPEAT_RATE_MIN 30
+
+// Click the buzzer on button presses. Follows the beep setting.
+#define BEEPER_BUTTON_CLICKS
+
+// Enable to get an additional DOUBLE press when a button is pressed twice
+// within this many milliseconds. Both SHORT presses are still reported.
+//#define BUTTON_DOUBLE_CLICK_DELAY 300
+
 #endif // file_defined
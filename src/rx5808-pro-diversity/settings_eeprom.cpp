@@ -1,16 +1,74 @@
 #include <string.h>
 #include <EEPROM.h>
+#include <util/crc16.h>
 
 #include "settings.h"
 #include "settings_internal.h"
 #include "settings_eeprom.h"
+#include "eeprom_writer.h"
 
 #include "timer.h"
 
 
+//
+// Settings are written as a log of records, each in its own fixed size slot.
+// Every save goes into the slot after the last one so writes are spread over
+// the whole EEPROM. The newest record is found by its sequence number and
+// validated by a CRC over header and payload. The header is written last and
+// acts as the commit marker: a save interrupted by power loss leaves a record
+// failing its CRC, so the previous one is still the newest valid record.
+//
+// Writes happen in the background through EepromWriter, from a copy of the
+// settings which stays untouched until the record is complete.
+//
+struct RecordHeader {
+    uint8_t version;
+    uint8_t size;
+    uint16_t sequence;
+    uint16_t crc;
+};
+
+#define SLOT_COUNT ((E2END + 1) / EEPROM_SLOT_SIZE)
+#define SLOT_ADDRESS(slot) ((slot) * EEPROM_SLOT_SIZE)
+#define PAYLOAD_ADDRESS(slot) (SLOT_ADDRESS(slot) + sizeof(RecordHeader))
+
+// Newer according to serial number arithmetic, so the sequence may wrap.
+#define SEQUENCE_NEWER(a, b) (static_cast<int16_t>((a) - (b)) > 0)
+
+// The legacy layout is exactly the version 1 payload prefixed by its magic.
+// Should fields ever be appended this must be pinned to the version 1 size.
+#define LEGACY_SIZE sizeof(EepromSettings)
+
+static_assert(
+    sizeof(RecordHeader) + sizeof(EepromSettings) <= EEPROM_SLOT_SIZE,
+    "EepromSettings does not fit into EEPROM_SLOT_SIZE"
+);
+static_assert(
+    sizeof(uint32_t) + LEGACY_SIZE <= EEPROM_SLOT_SIZE,
+    "Legacy settings must stay within slot 0"
+);
+static_assert(
+    SLOT_COUNT <= 32,
+    "Slot scan bitmask only covers 32 slots"
+);
+
+
+static uint16_t calculateCrc(
+    const RecordHeader &header,
+    const uint8_t *payload
+);
+
+
 static Timer saveTimer = Timer(EEPROM_SAVE_TIME);
 static bool isDirty = false;
 
+static uint8_t currentSlot = SLOT_COUNT - 1;
+static uint16_t currentSequence = 0;
+static bool hasRecord = false;
+
+static uint8_t recordPayload[sizeof(EepromSettings)];
+static RecordHeader recordHeader;
+
 
 struct EepromSettings EepromSettings;
 
@@ -27,17 +85,64 @@ void EepromSettings::update() {
 }
 
 void EepromSettings::load() {
-    EEPROM.get(0, *this);
+    if (this->loadRecord())
+        return;
 
-    if (this->magic != EEPROM_MAGIC)
-        this->initDefaults();
+    // The legacy settings lie within slot 0, so the first record goes into
+    // slot 1. They stay intact until that record is committed, and a save
+    // cut short by power loss is just migrated again on the next boot.
+    if (this->loadLegacy()) {
+        currentSlot = 0;
+        this->save();
+        return;
+    }
+
+    this->initDefaults();
 }
 
 void EepromSettings::save() {
-    EEPROM.put(0, *this);
+    // Retried from update() once the previous record is written out.
+    if (EepromWriter::isBusy()) {
+        isDirty = true;
+        return;
+    }
+
+    // Nothing to do if the newest record already holds these settings.
+    if (hasRecord && memcmp(recordPayload, this, sizeof(EepromSettings)) == 0)
+        return;
+
+    const uint8_t slot = (currentSlot + 1) % SLOT_COUNT;
+
+    memcpy(recordPayload, this, sizeof(EepromSettings));
+
+    recordHeader.version = EEPROM_VERSION;
+    recordHeader.size = sizeof(EepromSettings);
+    recordHeader.sequence = currentSequence + 1;
+    recordHeader.crc = calculateCrc(recordHeader, recordPayload);
+
+    EepromWriter::queue(
+        PAYLOAD_ADDRESS(slot),
+        recordPayload,
+        sizeof(EepromSettings)
+    );
+    EepromWriter::queue(
+        SLOT_ADDRESS(slot),
+        reinterpret_cast<const uint8_t *>(&recordHeader),
+        sizeof(RecordHeader)
+    );
+    EepromWriter::start();
+
+    currentSlot = slot;
+    currentSequence = recordHeader.sequence;
+    hasRecord = true;
 }
 
 void EepromSettings::markDirty() {
+    // Save a fixed time after the first change rather than the last, so a
+    // burst of changes still ends up as a single record.
+    if (!isDirty)
+        saveTimer.reset();
+
     isDirty = true;
 }
 
@@ -46,3 +151,104 @@ void EepromSettings::initDefaults() {
     memcpy_P(this, &EepromDefaults, sizeof(EepromDefaults));
     this->save();
 }
+
+
+bool EepromSettings::loadRecord() {
+    uint32_t rejected = 0;
+
+    // Only the headers are scanned, the CRC is checked for the newest
+    // candidate alone unless it turns out to be broken.
+    while (true) {
+        RecordHeader header;
+        RecordHeader bestHeader;
+        uint8_t bestSlot = SLOT_COUNT;
+
+        for (uint8_t slot = 0; slot < SLOT_COUNT; slot++) {
+            if (rejected & (1UL << slot))
+                continue;
+
+            EEPROM.get(SLOT_ADDRESS(slot), header);
+            if (
+                header.version == 0 ||
+                header.version > EEPROM_VERSION ||
+                header.size > EEPROM_SLOT_SIZE - sizeof(RecordHeader)
+            ) {
+                rejected |= 1UL << slot;
+                continue;
+            }
+
+            if (
+                bestSlot == SLOT_COUNT ||
+                SEQUENCE_NEWER(header.sequence, bestHeader.sequence)
+            ) {
+                bestSlot = slot;
+                bestHeader = header;
+            }
+        }
+
+        if (bestSlot == SLOT_COUNT)
+            return false;
+
+        uint8_t payload[EEPROM_SLOT_SIZE - sizeof(RecordHeader)];
+        for (uint8_t i = 0; i < bestHeader.size; i++)
+            payload[i] = EEPROM.read(PAYLOAD_ADDRESS(bestSlot) + i);
+
+        if (calculateCrc(bestHeader, payload) != bestHeader.crc) {
+            rejected |= 1UL << bestSlot;
+            continue;
+        }
+
+        // Older versions are migrated by laying their payload over the
+        // defaults, which works as fields are only ever appended.
+        memcpy_P(this, &EepromDefaults, sizeof(EepromDefaults));
+        memcpy(
+            this,
+            payload,
+            min(bestHeader.size, sizeof(EepromSettings))
+        );
+
+        memcpy(recordPayload, this, sizeof(EepromSettings));
+        currentSlot = bestSlot;
+        currentSequence = bestHeader.sequence;
+        hasRecord = bestHeader.version == EEPROM_VERSION;
+
+        if (!hasRecord)
+            this->save();
+
+        return true;
+    }
+}
+
+bool EepromSettings::loadLegacy() {
+    uint32_t magic;
+    EEPROM.get(0, magic);
+
+    if (magic != EEPROM_LEGACY_MAGIC)
+        return false;
+
+    memcpy_P(this, &EepromDefaults, sizeof(EepromDefaults));
+
+    uint8_t *payload = reinterpret_cast<uint8_t *>(this);
+    for (uint8_t i = 0; i < LEGACY_SIZE; i++)
+        payload[i] = EEPROM.read(sizeof(magic) + i);
+
+    return true;
+}
+
+
+static uint16_t calculateCrc(
+    const RecordHeader &header,
+    const uint8_t *payload
+) {
+    uint16_t crc = 0xFFFF;
+
+    crc = _crc16_update(crc, header.version);
+    crc = _crc16_update(crc, header.size);
+    crc = _crc16_update(crc, header.sequence & 0xFF);
+    crc = _crc16_update(crc, header.sequence >> 8);
+
+    for (uint8_t i = 0; i < header.size; i++)
+        crc = _crc16_update(crc, payload[i]);
+
+    return crc;
+}
@@ -11,7 +11,6 @@
 
 
 struct EepromSettings {
-    uint32_t magic;
     uint8_t startChannel;
 
     uint8_t beepEnabled;
@@ -42,11 +41,14 @@ struct EepromSettings {
     void markDirty();
 
     void initDefaults();
+
+    private:
+        bool loadRecord();
+        bool loadLegacy();
 };
 
 
 PROGMEM const struct {
-    uint32_t magic = EEPROM_MAGIC;
     uint8_t startChannel = 0;
 
     uint8_t beepEnabled = true;
@@ -32,8 +32,17 @@ SOFTWARE.
 
 // === EEPROM ==================================================================
 
-// This should be incremented after every EEPROM change.
-#define EEPROM_MAGIC 0x00000009
+// This should be incremented after every EEPROM change. New fields must only
+// ever be appended to EepromSettings so older records can be migrated.
+#define EEPROM_VERSION 1
+
+// Magic of the old layout which stored the settings as a single struct at
+// address 0. Found on first boot after upgrading and migrated into the log.
+#define EEPROM_LEGACY_MAGIC 0x00000009
+
+// Settings are stored as a log of fixed size records rotating through the
+// whole EEPROM. Must fit the record header plus EepromSettings.
+#define EEPROM_SLOT_SIZE 32
 
 // === Receiver Modules =========================================================
 
@@ -53,21 +62,149 @@ SOFTWARE.
 
 #ifdef SH1106
   #define OLED_VCCSTATE SH1106_SWITCHCAPVCC
-  #define OLED_CLASS Adafruit_SH1106
+  #define OLED_CLASS Sh1106Display
 #else
   #define OLED_VCCSTATE SSD1306_SWITCHCAPVCC
   #define OLED_CLASS Adafruit_SSD1306
 #endif
 
+// Type of Ui::display, picked at compile time so draw calls go straight to
+// the backend.
+#ifdef TVOUT_SCREENS
+  #define DISPLAY_CLASS TvoutDisplay
+#elif defined(OLED_PAGED)
+  #define DISPLAY_CLASS PagedDisplay
+#else
+  #define DISPLAY_CLASS OLED_CLASS
+#endif
+
+// Ui draws into the framebuffer itself where it can, which needs the buffer
+// of the display library. The TVout buffer is laid out by rows rather than
+// pages and OLED_PAGED has none.
+#if \
+    !defined(TVOUT_SCREENS) && \
+    !defined(OLED_PAGED) && \
+    !defined(BENCHMARK_GFX_ONLY)
+  #define OLED_DIRECT_BUFFER
+#endif
+
+#if defined(OLED_PAGED) && defined(SH1106)
+    #error "OLED_PAGED only works with the SSD1306."
+#endif
+
+#ifdef OLED_FAST_TWI
+    #ifdef TVOUT_SCREENS
+        #error "OLED_FAST_TWI only works with the OLEDs."
+    #endif
+
+    // Bus clock used when the display fails the self test at OLED_TWI_CLOCK.
+    #define TWI_CLOCK_SAFE 400000
+#endif
+
+// Scrolling on the display writes the uncovered columns from the framebuffer,
+// and the SH1106 has no such command.
+#if \
+    defined(OLED_HW_SCROLL) && \
+    (!defined(OLED_DIRECT_BUFFER) || defined(SH1106))
+  #undef OLED_HW_SCROLL
+#endif
+
+#ifdef OLED_HW_SCROLL
+    // The controller takes two frames for a one column step and must not
+    // get any other commands in between. At most this many columns are
+    // queued, beyond that the region is sent as a whole.
+    #define OLED_SCROLL_STEP 20
+    #define OLED_SCROLL_BACKLOG 12
+#endif
+
+// TvoutDisplay replaces the per pixel GFX primitives with bytewise ones.
+#if defined(TVOUT_SCREENS) && !defined(BENCHMARK_GFX_ONLY)
+  #define TVOUT_FAST_DRAW
+#endif
+
 #define OLED_FRAMERATE 1000 / 25
 
+#ifdef TVOUT_OSD
+    // Only these lines of the picture are rendered, so the line interrupt
+    // stays short on all others.
+    #define OSD_HEIGHT 16
+    #define OSD_VSCALE 2 // Scanlines per OSD line.
+
+    #ifdef TVOUT_NTSC
+        #define OSD_LINE_START 200
+    #else
+        #define OSD_LINE_START 250
+    #endif
+#endif
+
+// === ADC =====================================================================
+
+#define ADC_SLOTS_MAX 3
+
+// Samples summed per RSSI reading. Every 4x adds a bit of resolution.
+#define ADC_RSSI_SAMPLES 4
+
+// Convert in ADC noise reduction sleep. This halts the I/O clock, which would
+// garble serial output and stop the TVout line timer.
+#if \
+    !defined(USE_SERIAL_OUT) && \
+    !defined(USE_IR_EMITTER) && \
+    !defined(USE_BENCHMARK) && \
+    !defined(TVOUT_SCREENS)
+    #define ADC_NOISE_REDUCTION
+#endif
+
+// With TV out conversions are started from the line interrupt on lines
+// without pixel output and collected on the next line, so they neither pick
+// up the video signal nor delay the line interrupt.
+#ifdef TVOUT_SCREENS
+    #define ADC_LINE_TRIGGERED
+#endif
+
+// === Scheduler ===============================================================
+
+// Task periods in ms. Receiver first as RSSI and diversity switching want the
+// most predictable timing.
+#define TASK_PERIOD_RECEIVER 1
+#define TASK_PERIOD_BUTTONS 5
+#define TASK_PERIOD_STATE 1
+#define TASK_PERIOD_DRAW OLED_FRAMERATE
+#define TASK_PERIOD_UI 5
+#define TASK_PERIOD_EEPROM 100
+#define TASK_PERIOD_SCREENSAVER 100
+#define TASK_PERIOD_POWER 1000
+#define TASK_PERIOD_VOLTAGE 50
+#define TASK_PERIOD_BEEPER 5
+#define TASK_PERIOD_BENCHMARK 5000
+
+// === Power ===================================================================
+
+// Model for the estimated current draw, in 0.1mA. The MCU share is scaled by
+// the time it is awake. Calibrate POWER_CURRENT_BASE (receivers, regulator,
+// LEDs) against a meter for your own hardware.
+#define POWER_CURRENT_BASE 2400
+#define POWER_CURRENT_MCU_ACTIVE 150
+#define POWER_CURRENT_MCU_IDLE 40
+#define POWER_CURRENT_DISPLAY 120
+#define POWER_CURRENT_DISPLAY_DIMMED 40
+
 // === Misc ====================================================================
 
 #ifdef USE_VOLTAGE_MONITORING
     #define VBAT_SMOOTH 8
     #define VBAT_PRESCALER 16
+
+    // Battery is sampled every this many ADC rotations (about 1ms each).
+    #define VBAT_ROTATIONS 64
 #endif
 
 #define EEPROM_SAVE_TIME 5000
 
+#define BEEPER_QUEUE_MAX 4
+#define BEEPER_CLICK_MSEC 20
+
+// The screensaver ticker moves this often, in ms.
+#define SCREENSAVER_TICKER_PERIOD 40
+#define SCREENSAVER_TICKER_TEXT_MAX 32
+
 #endif // file_defined
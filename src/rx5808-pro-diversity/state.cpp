@@ -1,6 +1,7 @@
 #include <stddef.h>
 
 #include "state.h"
+#include "state_persistent.h"
 
 #include "state_screensaver.h"
 #include "state_search.h"
@@ -11,8 +12,7 @@
 
 #include "ui.h"
 #include "buttons.h"
-
-#include "timer.h"
+#include "benchmark.h"
 
 
 void *operator new(size_t size, void *ptr){
@@ -33,9 +33,13 @@ void *operator new(size_t size, void *ptr){
 namespace StateMachine {
     static void onButtonChange(Button button, Buttons::PressType pressType);
     static StateHandler *getStateHandler(State stateType);
+    #ifdef OLED_PAGED
+        static void drawPages();
+    #endif
 
 
     static uint8_t stateBuffer[STATE_BUFFER_SIZE];
+    PersistentData persistent = {};
     static StateHandler* currentHandler = nullptr;
     State currentState = State::BOOT;
     State lastState = currentState;
@@ -48,14 +52,26 @@ namespace StateMachine {
     void update() {
         if (currentHandler) {
             currentHandler->onUpdate();
+        }
+    }
 
-            // FIXME: This should probably be handled in the UI module but not
-            // 100% on how to decouple them at this stage
-            static Timer drawTimer = Timer(OLED_FRAMERATE);
-            if (currentHandler
-                && Ui::shouldDrawUpdate
-                && drawTimer.hasTicked()
-            ) {
+    // Run by the scheduler at OLED_FRAMERATE.
+    void draw() {
+        // Without a framebuffer a flush means drawing the pages again.
+        #ifdef OLED_PAGED
+            const bool shouldDraw = Ui::shouldDrawUpdate || Ui::shouldDisplay;
+        #else
+            const bool shouldDraw = Ui::shouldDrawUpdate;
+        #endif
+
+        if (currentHandler && shouldDraw) {
+            #ifdef USE_BENCHMARK
+                const uint32_t start = micros();
+            #endif
+
+            #ifdef OLED_PAGED
+                drawPages();
+            #else
                 if (Ui::shouldFullRedraw) {
                     currentHandler->onInitialDraw();
                     Ui::shouldFullRedraw = false;
@@ -63,8 +79,14 @@ namespace StateMachine {
 
                 currentHandler->onUpdateDraw();
                 Ui::shouldDrawUpdate = false;
-                drawTimer.reset();
-            }
+            #endif
+
+            #ifdef USE_BENCHMARK
+                Benchmark::recordDraw(
+                    static_cast<uint8_t>(currentState),
+                    micros() - start
+                );
+            #endif
         }
     }
 
@@ -79,10 +101,35 @@ namespace StateMachine {
 
         if (currentHandler != nullptr) {
             currentHandler->onEnter();
-            currentHandler->onInitialDraw();
+
+            #ifdef OLED_PAGED
+                Ui::needFullRedraw();
+                Ui::needUpdate();
+            #else
+                currentHandler->onInitialDraw();
+            #endif
         }
     }
 
+    #ifdef OLED_PAGED
+        // Nothing is kept between frames, so every page gets the whole
+        // screen drawn from scratch and then goes straight to the display.
+        static void drawPages() {
+            for (uint8_t page = 0; page < PAGED_PAGES; page++) {
+                Ui::display.setPage(page);
+
+                currentHandler->onInitialDraw();
+                currentHandler->onUpdateDraw();
+
+                Ui::display.flushPage();
+            }
+
+            Ui::shouldFullRedraw = false;
+            Ui::shouldDrawUpdate = false;
+            Ui::shouldDisplay = false;
+        }
+    #endif
+
     static StateHandler *getStateHandler(State state) {
         #define STATE_FACTORY(s, c) \
             case s: \
@@ -37,6 +37,7 @@ namespace StateMachine {
 
     void setup();
     void update();
+    void draw();
 
     void switchState(State newState);
 }
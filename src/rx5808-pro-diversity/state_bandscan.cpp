@@ -13,9 +13,10 @@
 #include "ui_menu.h"
 
 
+// Picks up the sweep where it was left.
 void StateMachine::BandScanStateHandler::onEnter() {
-    orderedChanelIndex = 0;
     lastChannelIndex = Receiver::activeChannel;
+    Receiver::setChannel(Channels::getOrderedIndex(sweep.orderedChanelIndex));
 }
 
 void StateMachine::BandScanStateHandler::onExit() {
@@ -27,20 +28,35 @@ void StateMachine::BandScanStateHandler::onUpdate() {
     if (!Receiver::isRssiStable())
         return;
 
+    uint8_t &index = sweep.orderedChanelIndex;
+
     #ifdef USE_DIVERSITY
-        rssiData[orderedChanelIndex] = (Receiver::rssiA + Receiver::rssiB) / 2;
+        sweep.rssiData[index] = (Receiver::rssiA + Receiver::rssiB) / 2;
     #else
-        rssiData[orderedChanelIndex] = Receiver::rssiA;
+        sweep.rssiData[index] = Receiver::rssiA;
     #endif
 
-    orderedChanelIndex = (orderedChanelIndex + 1) % (CHANNELS_SIZE);
-    Receiver::setChannel(Channels::getOrderedIndex(orderedChanelIndex));
+    index = (index + 1) % (CHANNELS_SIZE);
+    Receiver::setChannel(Channels::getOrderedIndex(index));
 
     Ui::needUpdate();
+}
 
-    if (orderedChanelIndex == 0) {
-
+void StateMachine::BandScanStateHandler::onButtonChange(
+    Button button,
+    Buttons::PressType pressType
+) {
+    if (
+        pressType != Buttons::PressType::SHORT ||
+        (button != Button::UP && button != Button::DOWN)
+    ) {
+        return;
     }
+
+    sweep.graphMode = sweep.graphMode == GraphMode::BARS ?
+        GraphMode::LINE : GraphMode::BARS;
+
+    Ui::needFullRedraw();
 }
 
 #define BORDER_LEFT_X 0
@@ -77,10 +93,63 @@ void StateMachine::BandScanStateHandler::onUpdate() {
 #define GRAPH_W (BORDER_RIGHT_X - GRAPH_X)
 #define GRAPH_H BORDER_BOTTOM_Y
 
+// Channels get a fixed column range each, with a one pixel gap between bars.
+#define BAR_X(index) (GRAPH_X + (index) * GRAPH_W / CHANNELS_SIZE)
+
 
 void StateMachine::BandScanStateHandler::onInitialDraw() {
     Ui::clear();
 
+    drawBorders();
+
+    if (sweep.graphMode == GraphMode::BARS) {
+        for (uint8_t i = 0; i < CHANNELS_SIZE; i++)
+            drawBar(i);
+
+        drawnIndex = sweep.orderedChanelIndex;
+        drawnProgressW = 0;
+        drawProgress();
+    }
+
+    Ui::needDisplay();
+}
+
+// Bar mode only redraws the channels sampled since the last frame and the
+// grown part of the progress bar, and flushes just those columns.
+void StateMachine::BandScanStateHandler::onUpdateDraw() {
+    if (sweep.graphMode == GraphMode::BARS) {
+        while (drawnIndex != sweep.orderedChanelIndex) {
+            drawBar(drawnIndex);
+            drawnIndex = (drawnIndex + 1) % CHANNELS_SIZE;
+        }
+
+        drawProgress();
+        return;
+    }
+
+    Ui::drawGraph(
+        sweep.rssiData,
+        CHANNELS_SIZE,
+        100,
+        GRAPH_X,
+        GRAPH_Y,
+        GRAPH_W,
+        GRAPH_H
+    );
+
+    Ui::display.drawFastHLine(
+        BORDER_BOTTOM_X,
+        BORDER_BOTTOM_Y,
+        BORDER_BOTTOM_W,
+        WHITE
+    );
+
+    drawProgress();
+
+    Ui::needDisplay();
+}
+
+void StateMachine::BandScanStateHandler::drawBorders() {
     Ui::display.drawFastVLine(
         BORDER_LEFT_X,
         BORDER_LEFT_Y,
@@ -131,27 +200,22 @@ void StateMachine::BandScanStateHandler::onInitialDraw() {
     Ui::display.setCursor(CHANNEL_TEXT_HIGH_X, CHANNEL_TEXT_HIGH_Y);
     Ui::display.print(
         Channels::getFrequency(Channels::getOrderedIndex(CHANNELS_SIZE - 1)));
-
-    Ui::needDisplay();
 }
 
-void StateMachine::BandScanStateHandler::onUpdateDraw() {
-    Ui::drawGraph(
-        rssiData,
-        CHANNELS_SIZE,
-        100,
-        GRAPH_X,
-        GRAPH_Y,
-        GRAPH_W,
-        GRAPH_H
-    );
+void StateMachine::BandScanStateHandler::drawBar(uint8_t index) {
+    const uint8_t x = BAR_X(index);
+    const uint8_t w = BAR_X(index + 1) - x - 1;
+    const uint8_t h = sweep.rssiData[index] * GRAPH_H / 100;
 
-    Ui::display.drawFastHLine(
-        BORDER_BOTTOM_X,
-        BORDER_BOTTOM_Y,
-        BORDER_BOTTOM_W,
-        WHITE
-    );
+    Ui::clearRect(x, GRAPH_Y, w, GRAPH_H - h);
+    Ui::fillRect(x, GRAPH_Y + GRAPH_H - h, w, h, WHITE);
+
+    Ui::needDisplayRect(x, GRAPH_Y, w, GRAPH_H);
+}
+
+void StateMachine::BandScanStateHandler::drawProgress() {
+    const uint8_t progressW =
+        sweep.orderedChanelIndex * PROGRESS_W / CHANNELS_SIZE + 1;
 
     Ui::clearRect(
         PROGRESS_X,
@@ -160,8 +224,7 @@ void StateMachine::BandScanStateHandler::onUpdateDraw() {
         PROGRESS_H
     );
 
-    uint8_t progressW = orderedChanelIndex * PROGRESS_W / CHANNELS_SIZE + 1;
-    Ui::display.fillRect(
+    Ui::fillRect(
         PROGRESS_X,
         PROGRESS_Y,
         progressW,
@@ -169,5 +232,17 @@ void StateMachine::BandScanStateHandler::onUpdateDraw() {
         WHITE
     );
 
-    Ui::needDisplay();
+    // Only the columns between the old and new end changed.
+    if (progressW != drawnProgressW) {
+        const uint8_t from = min(progressW, drawnProgressW);
+        const uint8_t to = max(progressW, drawnProgressW);
+
+        Ui::needDisplayRect(
+            PROGRESS_X + from,
+            PROGRESS_Y,
+            to - from,
+            PROGRESS_H
+        );
+        drawnProgressW = progressW;
+    }
 }
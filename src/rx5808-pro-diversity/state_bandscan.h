@@ -3,16 +3,26 @@
 
 #include <stdint.h>
 
-#include "channels.h"
 #include "state.h"
+#include "state_persistent.h"
 
 
 namespace StateMachine {
     class BandScanStateHandler : public StateMachine::StateHandler {
         private:
-            uint8_t orderedChanelIndex = 0;
+            typedef PersistentData::BandScan::GraphMode GraphMode;
+
+            PersistentData::BandScan &sweep = persistent.bandScan;
+
             uint8_t lastChannelIndex = 0;
-            uint8_t rssiData[CHANNELS_SIZE] = { 0 };
+
+            // Next channel to draw and drawn progress, for bar mode.
+            uint8_t drawnIndex = 0;
+            uint8_t drawnProgressW = 0;
+
+            void drawBorders();
+            void drawBar(uint8_t index);
+            void drawProgress();
 
         public:
             void onEnter();
@@ -21,6 +31,8 @@ namespace StateMachine {
 
             void onInitialDraw();
             void onUpdateDraw();
+
+            void onButtonChange(Button button, Buttons::PressType pressType);
     };
 }
 
@@ -46,9 +46,9 @@ static void settingsMenuHandler();
 
 void StateMachine::MenuStateHandler::onEnter() {
     this->menu.reset();
-    this->menu.addItem(PSTR("Search"), searchIcon, searchMenuHandler);
-    this->menu.addItem(PSTR("Band Scan"), bandScanIcon, bandScannerMenuHandler);
-    this->menu.addItem(PSTR("Settings"), settingsIcon, settingsMenuHandler);
+    this->menu.addItem(F("Search"), searchIcon, searchMenuHandler);
+    this->menu.addItem(F("Band Scan"), bandScanIcon, bandScannerMenuHandler);
+    this->menu.addItem(F("Settings"), settingsIcon, settingsMenuHandler);
 }
 
 
@@ -1,8 +1,9 @@
+#include <avr/pgmspace.h>
+
 #include "state.h"
 #include "state_menu.h"
 #include "ui.h"
 #include "ui_menu.h"
-#include "pstr_helper.h"
 
 
 #define TRIANGLE_SIZE 4
@@ -42,15 +43,14 @@ void StateMachine::MenuStateHandler::onUpdateDraw() {
 
 void StateMachine::MenuStateHandler::drawMenuEntry() {
     const Ui::MenuItem* item = this->menu.getCurrentItem();
-    const uint8_t charLen = strlen(PSTRtoBuffer_P(item->text));
+    const uint8_t charLen = strlen_P(reinterpret_cast<PGM_P>(item->text));
 
-    Ui::display.setTextSize(2);
-    Ui::display.setTextColor(WHITE);
-    Ui::display.setCursor(
+    Ui::drawText(
         SCREEN_WIDTH_MID - (charLen * ((CHAR_WIDTH + 1) * 2)) / 2,
-        TEXT_Y
+        TEXT_Y,
+        item->text,
+        2
     );
-    Ui::display.print(PSTRtoBuffer_P(item->text));
 
     if (item->icon) {
         Ui::clearRect(
@@ -60,7 +60,7 @@ void StateMachine::MenuStateHandler::drawMenuEntry() {
             GRAPHIC_SIZE
         );
 
-        Ui::display.drawBitmap(
+        Ui::drawBitmap(
             GRAPHIC_X,
             GRAPHIC_Y,
             item->icon,
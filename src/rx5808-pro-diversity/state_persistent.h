@@ -0,0 +1,33 @@
+#ifndef STATE_PERSISTENT_H
+#define STATE_PERSISTENT_H
+
+
+#include <stdint.h>
+
+#include "channels.h"
+
+
+namespace StateMachine {
+    //
+    // State data which outlives its handler. Handlers are constructed into
+    // the shared state buffer on every switch and only keep a view into
+    // this, so results are still around when coming back to a state.
+    //
+    struct PersistentData {
+        struct BandScan {
+            enum class GraphMode : uint8_t {
+                BARS,
+                LINE
+            };
+
+            GraphMode graphMode;
+            uint8_t orderedChanelIndex;
+            uint8_t rssiData[CHANNELS_SIZE];
+        } bandScan;
+    };
+
+    extern PersistentData persistent;
+}
+
+
+#endif
@@ -1,4 +1,5 @@
 #include <avr/pgmspace.h>
+#include <string.h>
 
 #include "state_screensaver.h"
 
@@ -9,6 +10,24 @@
 #include "ui.h"
 
 
+#define TICKER_Y (SCREEN_HEIGHT - 8)
+#define TICKER_H 8
+#define TICKER_STEP 2
+
+// The display scrolls a column per OLED_SCROLL_STEP and must keep up with the
+// ticker, otherwise it falls behind and the ticker is sent in full.
+#ifdef OLED_HW_SCROLL
+    static_assert(
+        TICKER_STEP * OLED_SCROLL_STEP <= SCREENSAVER_TICKER_PERIOD,
+        "Ticker moves faster than the display can scroll"
+    );
+#endif
+
+
+static char *appendText(char *dst, const char *text);
+static char *appendNumber(char *dst, uint16_t number);
+
+
 static const unsigned char PROGMEM logo[] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -79,6 +98,14 @@ static const unsigned char PROGMEM logo[] = {
 
 void StateMachine::ScreensaverStateHandler::onEnter() {
     showLogo = true;
+    Ui::setDimmed(true);
+
+    updateTickerText();
+    tickerX = SCREEN_WIDTH;
+}
+
+void StateMachine::ScreensaverStateHandler::onExit() {
+    Ui::setDimmed(false);
 }
 
 void StateMachine::ScreensaverStateHandler::onUpdate() {
@@ -88,6 +115,39 @@ void StateMachine::ScreensaverStateHandler::onUpdate() {
 
         Ui::needUpdate();
     }
+
+    if (showLogo && this->tickerTimer.hasTicked()) {
+        this->tickerTimer.reset();
+
+        tickerX -= TICKER_STEP;
+        if (tickerX <= -tickerW) {
+            tickerX += tickerW;
+            updateTickerText();
+        }
+
+        Ui::needUpdate();
+    }
+}
+
+void StateMachine::ScreensaverStateHandler::updateTickerText() {
+    char *text = tickerText;
+
+    text = appendText(text, Channels::getName(Receiver::activeChannel));
+    text = appendText(text, " ");
+    text = appendNumber(text, Channels::getFrequency(Receiver::activeChannel));
+    #ifdef USE_DIVERSITY
+        text = appendText(text, "   A ");
+        text = appendNumber(text, Receiver::rssiA);
+        text = appendText(text, "%  B ");
+        text = appendNumber(text, Receiver::rssiB);
+    #else
+        text = appendText(text, "   ");
+        text = appendNumber(text, Receiver::rssiA);
+    #endif
+    appendText(text, "%   ");
+
+    tickerW = strlen(tickerText) * (CHAR_WIDTH + 1);
+    tickerRevision++;
 }
 
 
@@ -103,7 +163,7 @@ void StateMachine::ScreensaverStateHandler::onInitialDraw() {
     Ui::clear();
 
     if (showLogo) {
-        Ui::display.drawBitmap(
+        Ui::drawBitmap(
             0,
             0,
             logo,
@@ -111,26 +171,79 @@ void StateMachine::ScreensaverStateHandler::onInitialDraw() {
             SCREEN_HEIGHT,
             WHITE
         );
-    } else {
-        Ui::display.setTextColor(WHITE);
 
-        Ui::display.setTextSize(6);
-        Ui::display.setCursor(
+        drawTicker();
+    } else {
+        Ui::drawText(
             SCREEN_WIDTH_MID - ((CHAR_WIDTH) * 6) / 2 * 2 - 3,
-            2);
-
-        Ui::display.print(Channels::getName(Receiver::activeChannel));
+            2,
+            Channels::getName(Receiver::activeChannel),
+            6
+        );
 
-        Ui::display.setTextSize(2);
-        Ui::display.setCursor(
+        Ui::drawNumber(
             SCREEN_WIDTH_MID - ((CHAR_WIDTH + 1) * 2) / 2 * 4 - 1,
-            SCREEN_HEIGHT - CHAR_HEIGHT * 2 - 2);
-        Ui::display.print(Channels::getFrequency(Receiver::activeChannel));
+            SCREEN_HEIGHT - CHAR_HEIGHT * 2 - 2,
+            Channels::getFrequency(Receiver::activeChannel),
+            2
+        );
     }
 
+    drawnLogo = showLogo;
     Ui::needDisplay();
 }
 
+// Unless the text was refreshed, the ticker has only moved left since it
+// was last drawn.
 void StateMachine::ScreensaverStateHandler::onUpdateDraw() {
-    this->onInitialDraw();
+    if (!showLogo || showLogo != drawnLogo) {
+        this->onInitialDraw();
+        return;
+    }
+
+    const int16_t distance = drawnTickerX - tickerX;
+    const bool moved =
+        tickerRevision == drawnTickerRevision &&
+        distance > 0 &&
+        distance < SCREEN_WIDTH;
+
+    Ui::clearRect(0, TICKER_Y, SCREEN_WIDTH, TICKER_H);
+    drawTicker();
+
+    if (moved) {
+        Ui::needDisplayScrolled(0, TICKER_Y, SCREEN_WIDTH, TICKER_H, distance);
+    } else {
+        Ui::needDisplayRect(0, TICKER_Y, SCREEN_WIDTH, TICKER_H);
+    }
+}
+
+// Repeated as often as it takes to fill the line.
+void StateMachine::ScreensaverStateHandler::drawTicker() {
+    for (int16_t x = tickerX; x < SCREEN_WIDTH; x += tickerW)
+        Ui::drawText(x, TICKER_Y + 1, tickerText, 1);
+
+    drawnTickerX = tickerX;
+    drawnTickerRevision = tickerRevision;
+}
+
+
+static char *appendText(char *dst, const char *text) {
+    while (*text != '\0')
+        *dst++ = *text++;
+
+    *dst = '\0';
+    return dst;
+}
+
+static char *appendNumber(char *dst, uint16_t number) {
+    char digits[6];
+    char *digit = &digits[sizeof(digits) - 1];
+
+    *digit = '\0';
+    do {
+        *--digit = '0' + number % 10;
+        number /= 10;
+    } while (number > 0);
+
+    return appendText(dst, digit);
 }
@@ -2,9 +2,12 @@
 #define STATE_SCREENSAVER_H
 
 
+#include <stdint.h>
+
 #include "state.h"
 #include "timer.h"
 #include "settings.h"
+#include "settings_internal.h"
 
 
 namespace StateMachine {
@@ -12,10 +15,25 @@ namespace StateMachine {
         private:
             Timer displaySwapTimer = Timer(SCREENSAVER_DISPLAY_CYCLE * 1000);
             bool showLogo = false;
+            bool drawnLogo = false;
+
+            // Live channel and RSSI running along the bottom of the logo,
+            // the text is refreshed every time it has gone by once.
+            Timer tickerTimer = Timer(SCREENSAVER_TICKER_PERIOD);
+            char tickerText[SCREENSAVER_TICKER_TEXT_MAX];
+            int16_t tickerX = 0;
+            int16_t tickerW = 0;
+            uint8_t tickerRevision = 0;
+            int16_t drawnTickerX = 0;
+            uint8_t drawnTickerRevision = 0;
+
+            void updateTickerText();
+            void drawTicker();
 
         public:
             void onEnter();
             void onUpdate();
+            void onExit();
 
             void onInitialDraw();
             void onUpdateDraw();
@@ -8,13 +8,21 @@
 #include "receiver.h"
 #include "channels.h"
 #include "buttons.h"
+#include "beeper.h"
 #include "ui.h"
-#include "pstr_helper.h"
 
 
 using StateMachine::SearchStateHandler;
 
 
+static const Buttons::RepeatConfig manualRepeat = {
+    SEARCH_REPEAT_DELAY,
+    SEARCH_REPEAT_RATE,
+    SEARCH_REPEAT_ACCELERATION,
+    SEARCH_REPEAT_RATE_MIN
+};
+
+
 const unsigned char autoIcon[] PROGMEM = {
     0x00, 0x00, 0x1E, 0x00, 0x3F, 0x00, 0x73, 0x80, 0x61, 0x98, 0x7F, 0x84, 0x7F, 0x82, 0x61, 0x82,
     0x61, 0x80, 0x61, 0x80, 0x61, 0xA2, 0x08, 0x36, 0x08, 0x2A, 0x04, 0x22, 0x03, 0x22, 0x00, 0x00
@@ -57,6 +65,7 @@ static const unsigned char* menuOrderIcon(void* state) {
 static void menuModeHandler(void* state) {
     SearchStateHandler* search = static_cast<SearchStateHandler*>(state);
     search->manual = !search->manual;
+    search->updateButtonRepeat();
 
     EepromSettings.searchManual = search->manual;
     EepromSettings.markDirty();
@@ -99,6 +108,13 @@ void SearchStateHandler::onEnter() {
                 Channels::getOrderedIndexFromIndex(EepromSettings.startChannel);
             break;
     }
+
+    this->updateButtonRepeat();
+}
+
+void SearchStateHandler::onExit() {
+    Buttons::setRepeat(Button::UP, nullptr);
+    Buttons::setRepeat(Button::DOWN, nullptr);
 }
 
 void SearchStateHandler::onUpdate() {
@@ -135,6 +151,7 @@ void SearchStateHandler::onUpdateAuto() {
             EepromSettings.markDirty();
 
             scanningPeak = false;
+            Beeper::play(Beeper::Pattern::LOCK_FOUND);
         } else {
             Receiver::setChannel(Channels::getOrderedIndex(peakChannelIndex));
         }
@@ -184,6 +201,14 @@ void SearchStateHandler::onButtonChange(
         direction = button == Button::UP ?
             ScanDirection::UP : ScanDirection::DOWN;
     } else {
+        if (button != Button::UP && button != Button::DOWN)
+            return;
+
+        if (pressType == Buttons::PressType::HOLDING_END) {
+            this->setChannel();
+            return;
+        }
+
         if (
             pressType != Buttons::PressType::SHORT &&
             pressType != Buttons::PressType::HOLDING
@@ -202,19 +227,46 @@ void SearchStateHandler::onButtonChange(
         else if (orderedChanelIndex >= CHANNELS_SIZE)
             orderedChanelIndex = 0;
 
-        this->setChannel();
+        if (pressType == Buttons::PressType::HOLDING) {
+            if (manualTuneTimer.hasTicked()) {
+                Receiver::setChannel(this->getSelectedChannel());
+                manualTuneTimer.reset();
+            }
+        } else {
+            this->setChannel();
+        }
     }
 }
 
 void SearchStateHandler::setChannel() {
-    uint8_t actualChannelIndex;
-    if (this->order == ScanOrder::FREQUENCY) {
-        actualChannelIndex = Channels::getOrderedIndex(orderedChanelIndex);
-    } else {
-        actualChannelIndex = orderedChanelIndex;
-    }
+    uint8_t actualChannelIndex = this->getSelectedChannel();
 
     Receiver::setChannel(actualChannelIndex);
     EepromSettings.startChannel = actualChannelIndex;
     EepromSettings.markDirty();
 }
+
+uint8_t SearchStateHandler::getSelectedChannel() {
+    if (this->order == ScanOrder::FREQUENCY) {
+        return Channels::getOrderedIndex(orderedChanelIndex);
+    } else {
+        return orderedChanelIndex;
+    }
+}
+
+// While stepping manually the receiver lags behind the selection, so show
+// what is selected rather than what is tuned.
+uint8_t SearchStateHandler::getDisplayedChannel() {
+    if (this->manual)
+        return this->getSelectedChannel();
+
+    return Receiver::activeChannel;
+}
+
+void SearchStateHandler::updateButtonRepeat() {
+    const Buttons::RepeatConfig *repeat =
+        this->manual ? &manualRepeat : nullptr;
+
+    Buttons::setRepeat(Button::UP, repeat);
+    Buttons::setRepeat(Button::DOWN, repeat);
+}
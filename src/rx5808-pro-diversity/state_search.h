@@ -4,10 +4,16 @@
 
 #include "state.h"
 #include "ui_state_menu.h"
+#include "timer.h"
+#include "settings.h"
 
 
 #define PEAK_LOOKAHEAD 4
 
+// While stepping through channels by holding a button, only tune the receiver
+// this often (ms). The final channel is tuned once the button is released.
+#define MANUAL_TUNE_INTERVAL 150
+
 
 namespace StateMachine {
     class SearchStateHandler : public StateMachine::StateHandler {
@@ -26,6 +32,16 @@ namespace StateMachine {
             uint8_t peakChannelIndex = 0;
             uint8_t peaks[PEAK_LOOKAHEAD] = { 0 };
 
+            Timer manualTuneTimer = Timer(MANUAL_TUNE_INTERVAL);
+
+            // What the screen currently shows, to only redraw what changed.
+            uint8_t drawnChannel = 0;
+            uint8_t drawnScanWidth = 0;
+            uint8_t drawnRssiCount = 0;
+            #ifdef USE_VOLTAGE_MONITORING
+                uint8_t drawnVoltage = 0;
+            #endif
+
             bool menuShowing = true;
             Ui::StateMenuHelper menu = Ui::StateMenuHelper(this);
 
@@ -36,9 +52,15 @@ namespace StateMachine {
             void drawFrequencyText();
             void drawScanBar();
             void drawRssiGraph();
+            void drawRssiLabels();
+            void scrollRssiGraph(uint8_t newSamples);
+            bool hasInfoChanged();
+            void updateDrawnInfo();
             void drawMenu();
 
             void setChannel();
+            uint8_t getSelectedChannel();
+            uint8_t getDisplayedChannel();
 
         public:
             enum class ScanOrder : uint8_t {
@@ -52,12 +74,15 @@ namespace StateMachine {
             uint8_t orderedChanelIndex = 0;
 
             void onEnter();
+            void onExit();
             void onUpdate();
 
             void onInitialDraw();
             void onUpdateDraw();
 
             void onButtonChange(Button button, Buttons::PressType pressType);
+
+            void updateButtonRepeat();
     };
 }
 
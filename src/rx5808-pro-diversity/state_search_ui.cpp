@@ -2,8 +2,8 @@
 
 #include "receiver.h"
 #include "channels.h"
+#include "voltage.h"
 #include "ui.h"
-#include "pstr_helper.h"
 
 
 #define BORDER_GRAPH_L_X 59
@@ -33,7 +33,8 @@
 #define GRAPH_SEPERATOR_STEP 3
 
 #define GRAPH_X (BORDER_GRAPH_L_X + 2)
-#define GRAPH_W (SCREEN_WIDTH - BORDER_GRAPH_L_X)
+#define GRAPH_W (SCREEN_WIDTH - GRAPH_X)
+#define GRAPH_STEP 3
 #ifdef USE_DIVERSITY
     #define GRAPH_H (GRAPH_SEPERATOR_Y - 2)
     #define GRAPH_A_Y 0
@@ -64,50 +65,90 @@ void StateMachine::SearchStateHandler::onInitialDraw() {
     drawScanBar();
     drawRssiGraph();
 
+    updateDrawnInfo();
+    drawnRssiCount = Receiver::rssiLastCount;
+
     Ui::needDisplay();
 }
 
+// Only the parts which changed are drawn and flushed. The graph is scrolled
+// by the number of samples logged since the last frame.
 void StateMachine::SearchStateHandler::onUpdateDraw() {
-    Ui::clearRect(
-        0,
-        0,
-        BORDER_GRAPH_L_X,
-        CHANNEL_TEXT_H
-    );
+    const bool menuVisible = menu.isVisible();
+
+    if (menuVisible || hasInfoChanged()) {
+        Ui::clearRect(
+            0,
+            0,
+            BORDER_GRAPH_L_X,
+            CHANNEL_TEXT_H
+        );
 
-    Ui::clearRect(
-        0,
-        FREQUENCY_TEXT_Y,
-        BORDER_GRAPH_L_X,
-        CHAR_HEIGHT * 2
-    );
+        Ui::clearRect(
+            0,
+            FREQUENCY_TEXT_Y,
+            BORDER_GRAPH_L_X,
+            CHAR_HEIGHT * 2
+        );
 
-    Ui::clearRect(
-        SCANBAR_X,
-        SCANBAR_Y,
-        SCANBAR_W,
-        SCANBAR_H
-    );
+        Ui::clearRect(
+            SCANBAR_BORDER_X,
+            SCANBAR_BORDER_Y,
+            SCANBAR_BORDER_W,
+            SCANBAR_BORDER_H
+        );
 
-    drawChannelText();
-    drawFrequencyText();
-    drawScanBar();
-    drawRssiGraph();
-    menu.draw();
+        drawChannelText();
+        drawFrequencyText();
+        drawScanBar();
+
+        updateDrawnInfo();
+        Ui::needDisplayColumns(0, BORDER_GRAPH_L_X);
+    }
+
+    // The menu slides over the graph, which must not be scrolled along.
+    if (menuVisible) {
+        drawRssiGraph();
+        menu.draw();
+
+        drawnRssiCount = Receiver::rssiLastCount;
+        Ui::needDisplay();
+    } else {
+        const uint8_t newSamples = Receiver::rssiLastCount - drawnRssiCount;
+        if (newSamples > 0) {
+            scrollRssiGraph(newSamples);
+
+            drawnRssiCount += newSamples;
+            Ui::needDisplayColumns(GRAPH_X, GRAPH_W);
+        }
+    }
+}
 
-    Ui::needDisplay();
+bool StateMachine::SearchStateHandler::hasInfoChanged() {
+    #ifdef USE_VOLTAGE_MONITORING
+        const uint8_t voltage =
+            Voltage::alarm != Voltage::Alarm::NONE ? Voltage::voltage : 0;
+
+        if (voltage != drawnVoltage)
+            return true;
+    #endif
+
+    return
+        getDisplayedChannel() != drawnChannel ||
+        orderedChanelIndex * SCANBAR_W / CHANNELS_SIZE != drawnScanWidth;
 }
 
-void StateMachine::SearchStateHandler::drawBorders() {
-    display.drawRoundRect(
-        SCANBAR_BORDER_X,
-        SCANBAR_BORDER_Y,
-        SCANBAR_BORDER_W,
-        SCANBAR_BORDER_H,
-        2,
-        WHITE
-    );
+void StateMachine::SearchStateHandler::updateDrawnInfo() {
+    #ifdef USE_VOLTAGE_MONITORING
+        drawnVoltage =
+            Voltage::alarm != Voltage::Alarm::NONE ? Voltage::voltage : 0;
+    #endif
+
+    drawnChannel = getDisplayedChannel();
+    drawnScanWidth = orderedChanelIndex * SCANBAR_W / CHANNELS_SIZE;
+}
 
+void StateMachine::SearchStateHandler::drawBorders() {
     Ui::drawDashedVLine(
         BORDER_GRAPH_L_X,
         0,
@@ -117,25 +158,62 @@ void StateMachine::SearchStateHandler::drawBorders() {
 }
 
 void StateMachine::SearchStateHandler::drawChannelText() {
-    display.setTextSize(CHANNEL_TEXT_SIZE);
-    display.setTextColor(WHITE);
-    display.setCursor(CHANNEL_TEXT_X, CHANENL_TEXT_Y);
-
-    display.print(Channels::getName(Receiver::activeChannel));
+    Ui::drawText(
+        CHANNEL_TEXT_X,
+        CHANENL_TEXT_Y,
+        Channels::getName(getDisplayedChannel()),
+        CHANNEL_TEXT_SIZE
+    );
 }
 
 void StateMachine::SearchStateHandler::drawFrequencyText() {
-    display.setTextSize(FREQUENCY_TEXT_SIZE);
-    display.setTextColor(WHITE);
-    display.setCursor(FREQUENCY_TEXT_X, FREQUENCY_TEXT_Y);
-
-    display.print(Channels::getFrequency(Receiver::activeChannel));
+    Ui::drawNumber(
+        FREQUENCY_TEXT_X,
+        FREQUENCY_TEXT_Y,
+        Channels::getFrequency(getDisplayedChannel()),
+        FREQUENCY_TEXT_SIZE
+    );
 }
 
+// Replaced by the battery voltage while it is low.
 void StateMachine::SearchStateHandler::drawScanBar() {
+    #ifdef USE_VOLTAGE_MONITORING
+        if (Voltage::alarm != Voltage::Alarm::NONE) {
+            display.fillRoundRect(
+                SCANBAR_BORDER_X,
+                SCANBAR_BORDER_Y,
+                SCANBAR_BORDER_W,
+                SCANBAR_BORDER_H,
+                2,
+                WHITE
+            );
+
+            display.setTextSize(1);
+            display.setTextColor(BLACK);
+            display.setCursor(SCANBAR_BORDER_X + 1, SCANBAR_BORDER_Y);
+            display.print(F("BAT "));
+            display.print(Voltage::voltage / 10);
+            display.print(F("."));
+            display.print(Voltage::voltage % 10);
+            display.print(F("V"));
+            display.setTextColor(WHITE);
+
+            return;
+        }
+    #endif
+
+    display.drawRoundRect(
+        SCANBAR_BORDER_X,
+        SCANBAR_BORDER_Y,
+        SCANBAR_BORDER_W,
+        SCANBAR_BORDER_H,
+        2,
+        WHITE
+    );
+
     uint8_t scanWidth = orderedChanelIndex * SCANBAR_W / CHANNELS_SIZE;
 
-    display.fillRect(
+    Ui::fillRect(
         SCANBAR_X,
         SCANBAR_Y,
         scanWidth,
@@ -146,24 +224,26 @@ void StateMachine::SearchStateHandler::drawScanBar() {
 
 void StateMachine::SearchStateHandler::drawRssiGraph() {
     #ifdef USE_DIVERSITY
-        Ui::drawGraph(
+        Ui::drawScrollingGraph(
             Receiver::rssiBLast,
             RECEIVER_LAST_DATA_SIZE,
             100,
             GRAPH_X,
             GRAPH_A_Y,
             GRAPH_W,
-            GRAPH_H
+            GRAPH_H,
+            GRAPH_STEP
         );
 
-        Ui::drawGraph(
+        Ui::drawScrollingGraph(
             Receiver::rssiALast,
             RECEIVER_LAST_DATA_SIZE,
             100,
             GRAPH_X,
             GRAPH_B_Y,
             GRAPH_W,
-            GRAPH_H
+            GRAPH_H,
+            GRAPH_STEP
         );
 
         Ui::drawDashedHLine(
@@ -173,23 +253,77 @@ void StateMachine::SearchStateHandler::drawRssiGraph() {
             GRAPH_SEPERATOR_STEP
         );
 
+        drawRssiLabels();
+    #else
+        Ui::drawScrollingGraph(
+            Receiver::rssiALast,
+            RECEIVER_LAST_DATA_SIZE,
+            100,
+            GRAPH_X,
+            GRAPH_Y,
+            GRAPH_W,
+            GRAPH_H,
+            GRAPH_STEP
+        );
+    #endif
+}
+
+// Labels are drawn inverted, drawing them twice removes them again.
+void StateMachine::SearchStateHandler::drawRssiLabels() {
+    #ifdef USE_DIVERSITY
         display.setTextSize(RX_TEXT_SIZE);
         display.setTextColor(INVERSE);
 
         display.setCursor(RX_TEXT_X, RX_TEXT_A_Y);
-        display.print(PSTR2("B"));
+        display.print(F("B"));
 
         display.setCursor(RX_TEXT_X, RX_TEXT_B_Y);
-        display.print(PSTR2("A"));
+        display.print(F("A"));
+
+        display.setTextColor(WHITE);
+    #endif
+}
+
+void StateMachine::SearchStateHandler::scrollRssiGraph(uint8_t newSamples) {
+    #ifdef USE_DIVERSITY
+        drawRssiLabels();
+
+        Ui::scrollGraph(
+            Receiver::rssiBLast,
+            RECEIVER_LAST_DATA_SIZE,
+            100,
+            GRAPH_X,
+            GRAPH_A_Y,
+            GRAPH_W,
+            GRAPH_H,
+            GRAPH_STEP,
+            newSamples
+        );
+
+        Ui::scrollGraph(
+            Receiver::rssiALast,
+            RECEIVER_LAST_DATA_SIZE,
+            100,
+            GRAPH_X,
+            GRAPH_B_Y,
+            GRAPH_W,
+            GRAPH_H,
+            GRAPH_STEP,
+            newSamples
+        );
+
+        drawRssiLabels();
     #else
-        Ui::drawGraph(
+        Ui::scrollGraph(
             Receiver::rssiALast,
             RECEIVER_LAST_DATA_SIZE,
             100,
             GRAPH_X,
             GRAPH_Y,
             GRAPH_W,
-            GRAPH_H
+            GRAPH_H,
+            GRAPH_STEP,
+            newSamples
         );
     #endif
 }
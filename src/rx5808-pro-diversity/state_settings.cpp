@@ -5,8 +5,12 @@
 #include "state.h"
 #include "buttons.h"
 #include "ui.h"
+#include "power.h"
+#include "adc.h"
+#include "voltage.h"
+
+#include "settings_internal.h"
 
-#include "pstr_helper.h"
 
 
 void StateMachine::SettingsStateHandler::onEnter() {
@@ -18,7 +22,15 @@ void StateMachine::SettingsStateHandler::onExit() {
 }
 
 void StateMachine::SettingsStateHandler::onUpdate() {
+    if (refreshTimer.hasTicked()) {
+        refreshTimer.reset();
+
+        const uint16_t rotation = Adc::getRotation();
+        rotationRate = rotation - lastRotation;
+        lastRotation = rotation;
 
+        Ui::needUpdate();
+    }
 }
 
 void StateMachine::SettingsStateHandler::onButtonChange(
@@ -31,16 +43,59 @@ void StateMachine::SettingsStateHandler::onButtonChange(
 }
 
 
+#define DEBUG_TEXT_Y 24
+#define DEBUG_LINE_H (CHAR_HEIGHT + 1)
+
+
 void StateMachine::SettingsStateHandler::onInitialDraw() {
     Ui::clear();
 
     Ui::display.setTextSize(1);
     Ui::display.setCursor(0, 0);
-    Ui::display.print(PSTR2("Press mode for\nRSSI calibration"));
+    Ui::display.print(F("Press mode for\nRSSI calibration"));
 
-    Ui::needDisplay();
+    this->onUpdateDraw();
 }
 
 void StateMachine::SettingsStateHandler::onUpdateDraw() {
+    Ui::clearRect(
+        0,
+        DEBUG_TEXT_Y,
+        SCREEN_WIDTH,
+        SCREEN_HEIGHT - DEBUG_TEXT_Y
+    );
+
+    Ui::display.setTextSize(1);
+    Ui::display.setCursor(0, DEBUG_TEXT_Y);
+    Ui::display.print(F("RSSI: "));
+    Ui::display.print(ADC_RSSI_SAMPLES);
+    Ui::display.print(F("x +"));
+    Ui::display.print(Adc::getResolutionGain(ADC_RSSI_SAMPLES));
+    Ui::display.print(F("bit "));
+    Ui::display.print(rotationRate);
+    Ui::display.print(F("/s"));
+
+    #ifdef USE_VOLTAGE_MONITORING
+        Ui::display.setCursor(0, DEBUG_TEXT_Y + DEBUG_LINE_H);
+        Ui::display.print(F("Battery: "));
+        Ui::display.print(Voltage::voltage / 10);
+        Ui::display.print(F("."));
+        Ui::display.print(Voltage::voltage % 10);
+        Ui::display.print(F("V"));
+    #endif
+
+    Ui::display.setCursor(0, DEBUG_TEXT_Y + DEBUG_LINE_H * 3);
+    Ui::display.print(F("CPU load: "));
+    Ui::display.print(Power::getLoad());
+    Ui::display.print(F("%"));
+
+    const uint16_t current = Power::getCurrent();
+    Ui::display.setCursor(0, DEBUG_TEXT_Y + DEBUG_LINE_H * 4);
+    Ui::display.print(F("Current: ~"));
+    Ui::display.print(current / 10);
+    Ui::display.print(F("."));
+    Ui::display.print(current % 10);
+    Ui::display.print(F("mA"));
 
+    Ui::needDisplay();
 }
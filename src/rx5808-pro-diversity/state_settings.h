@@ -3,10 +3,16 @@
 
 
 #include "state.h"
+#include "timer.h"
 
 
 namespace StateMachine {
     class SettingsStateHandler : public StateMachine::StateHandler {
+        private:
+            Timer refreshTimer = Timer(1000);
+            uint16_t lastRotation = 0;
+            uint16_t rotationRate = 0;
+
         public:
             void onEnter();
             void onExit();
@@ -11,7 +11,6 @@
 #include "buttons.h"
 
 #include "ui.h"
-#include "pstr_helper.h"
 
 
 void StateMachine::SettingsRssiStateHandler::onEnter() {
@@ -115,42 +114,42 @@ void StateMachine::SettingsRssiStateHandler::onUpdateDraw() {
         case InternalState::WAIT_FOR_LOW:
             Ui::display.setTextSize(1);
             Ui::display.setCursor(0, 0);
-            Ui::display.print(PSTR2("1/4\nTurn off all VTXs."));
+            Ui::display.print(F("1/4\nTurn off all VTXs."));
             Ui::display.setCursor(0, (CHAR_HEIGHT + 1) * 2);
-            Ui::display.print(PSTR2("Remove RX antennas."));
+            Ui::display.print(F("Remove RX antennas."));
 
             Ui::display.setCursor(0, SCREEN_HEIGHT - CHAR_HEIGHT - 1);
-            Ui::display.print(PSTR2("Press MODE when ready."));
+            Ui::display.print(F("Press MODE when ready."));
         break;
 
         case InternalState::SCANNING_LOW:
             Ui::display.setTextSize(1);
             Ui::display.setCursor(0, 0);
-            Ui::display.print(PSTR2("2/4\nScanning for lowest\nRSSI..."));
+            Ui::display.print(F("2/4\nScanning for lowest\nRSSI..."));
         break;
 
         case InternalState::WAIT_FOR_HIGH:
             Ui::display.setTextSize(1);
             Ui::display.setCursor(0, 0);
-            Ui::display.print(PSTR2("3/4\nTurn on your VTX."));
+            Ui::display.print(F("3/4\nTurn on your VTX."));
 
             Ui::display.setCursor(0, SCREEN_HEIGHT - CHAR_HEIGHT - 1);
-            Ui::display.print(PSTR2("Press MODE when ready."));
+            Ui::display.print(F("Press MODE when ready."));
         break;
 
         case InternalState::SCANNING_HIGH:
             Ui::display.setTextSize(1);
             Ui::display.setCursor(0, 0);
-            Ui::display.print(PSTR2("4/4\nScanning for highest\nRSSI..."));
+            Ui::display.print(F("4/4\nScanning for highest\nRSSI..."));
         break;
 
         case InternalState::DONE:
             Ui::display.setTextSize(1);
             Ui::display.setCursor(0, 0);
-            Ui::display.print(PSTR2("All done!"));
+            Ui::display.print(F("All done!"));
 
             Ui::display.setCursor(0, CHAR_HEIGHT * 2);
-            Ui::display.print(PSTR2("Min: "));
+            Ui::display.print(F("Min: "));
 
             Ui::display.setCursor((CHAR_WIDTH + 1) * 5, CHAR_HEIGHT * 2);
             Ui::display.print(EepromSettings.rssiAMin);
@@ -160,7 +159,7 @@ void StateMachine::SettingsRssiStateHandler::onUpdateDraw() {
             #endif
 
             Ui::display.setCursor(0, CHAR_HEIGHT * 3 + 1);
-            Ui::display.print(PSTR2("Max: "));
+            Ui::display.print(F("Max: "));
 
             Ui::display.setCursor((CHAR_WIDTH + 1) * 5, CHAR_HEIGHT * 3 + 1);
             Ui::display.print(EepromSettings.rssiAMax);
@@ -171,7 +170,7 @@ void StateMachine::SettingsRssiStateHandler::onUpdateDraw() {
             #endif
 
             Ui::display.setCursor(0, SCREEN_HEIGHT - CHAR_HEIGHT - 1);
-            Ui::display.print(PSTR2("Press MODE to save."));
+            Ui::display.print(F("Press MODE to save."));
         break;
     }
 
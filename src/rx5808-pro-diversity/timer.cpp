@@ -2,9 +2,19 @@
 #include "timer.h"
 
 
+uint32_t Timer::now = 0;
+uint32_t Timer::nowMicros = 0;
+
+
+void Timer::tick() {
+    now = millis();
+    nowMicros = micros();
+}
+
+
 Timer::Timer(uint16_t delay) {
     this->delay = delay;
-    this->nextTick = millis() + this->delay;
+    this->start = now;
     this->ticked = false;
 }
 
@@ -12,7 +22,7 @@ const bool Timer::hasTicked() {
     if (this->ticked)
         return true;
 
-    if (millis() >= this->nextTick) {
+    if (now - this->start >= this->delay) {
         this->ticked = true;
         return true;
     }
@@ -21,6 +31,30 @@ const bool Timer::hasTicked() {
 }
 
 void Timer::reset() {
-    this->nextTick = millis() + this->delay;
+    this->start = now;
+    this->ticked = false;
+}
+
+
+MicroTimer::MicroTimer(uint16_t delay) {
+    this->delay = delay;
+    this->start = Timer::nowMicros;
+    this->ticked = false;
+}
+
+const bool MicroTimer::hasTicked() {
+    if (this->ticked)
+        return true;
+
+    if (Timer::nowMicros - this->start >= this->delay) {
+        this->ticked = true;
+        return true;
+    }
+
+    return false;
+}
+
+void MicroTimer::reset() {
+    this->start = Timer::nowMicros;
     this->ticked = false;
 }
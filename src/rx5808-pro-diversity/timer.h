@@ -5,17 +5,40 @@
 #include <stdint.h>
 
 
+//
+// Timers don't read the clock themselves but compare against a tick captured
+// once per scheduler pass by Timer::tick(). All arithmetic is on differences,
+// so timers keep working across the millis()/micros() wrap.
+//
 class Timer {
     private:
-        uint32_t nextTick;
+        uint32_t start;
         uint16_t delay;
         bool ticked;
 
     public:
+        static uint32_t now;
+        static uint32_t nowMicros;
+
+        static void tick();
+
         Timer(uint16_t delay);
         const bool hasTicked();
         void reset();
 };
 
+// Same as Timer but with microsecond resolution, for delays up to 65ms.
+class MicroTimer {
+    private:
+        uint32_t start;
+        uint16_t delay;
+        bool ticked;
+
+    public:
+        MicroTimer(uint16_t delay);
+        const bool hasTicked();
+        void reset();
+};
+
 
 #endif
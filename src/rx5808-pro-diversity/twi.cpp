@@ -0,0 +1,136 @@
+#include <Arduino.h>
+#include <avr/io.h>
+#include <util/twi.h>
+#include <stdint.h>
+
+#include "settings.h"
+#include "settings_internal.h"
+
+#ifdef OLED_FAST_TWI
+
+#include "twi.h"
+
+
+// Polls per bus event before giving up on a hung bus. A byte takes about 10
+// bus clocks, far below this at any usable clock.
+#define TWI_TIMEOUT 2000
+
+// SSD1306 no-op command, sent by the self test.
+#define TWI_TEST_BYTE 0xE3
+#define TWI_TEST_LENGTH 64
+#define TWI_TEST_ROUNDS 8
+
+
+static uint8_t deviceAddress = 0;
+static uint8_t bitRate = 0;
+
+
+static void setBitRate(uint32_t clock);
+static bool waitForBus();
+static bool start();
+static bool send(const uint8_t value, const uint8_t status);
+static void stop();
+
+
+namespace Twi {
+    // Falls back to TWI_CLOCK_SAFE if the display doesn't acknowledge every
+    // byte at the requested clock.
+    void setup(uint8_t address, uint32_t clock) {
+        deviceAddress = address;
+
+        setBitRate(clock);
+        if (!selfTest())
+            setBitRate(TWI_CLOCK_SAFE);
+    }
+
+    // Rows of a single byte with no stride repeat that byte.
+    bool selfTest() {
+        static const uint8_t test = TWI_TEST_BYTE;
+
+        for (uint8_t i = 0; i < TWI_TEST_ROUNDS; i++) {
+            if (!write(0x00, &test, 1, TWI_TEST_LENGTH, 0))
+                return false;
+        }
+
+        return true;
+    }
+
+    uint32_t getClock() {
+        return F_CPU / (16 + 2 * static_cast<uint16_t>(bitRate));
+    }
+
+    bool write(
+        const uint8_t control,
+        const uint8_t *data,
+        const uint8_t width,
+        const uint8_t rows,
+        const uint8_t stride
+    ) {
+        return write(&control, 1, data, width, rows, stride);
+    }
+
+    bool write(
+        const uint8_t *header,
+        const uint8_t headerSize,
+        const uint8_t *data,
+        const uint8_t width,
+        const uint8_t rows,
+        const uint8_t stride
+    ) {
+        bool ok = start() && send(deviceAddress << 1, TW_MT_SLA_ACK);
+
+        for (uint8_t i = 0; ok && i < headerSize; i++)
+            ok = send(header[i], TW_MT_DATA_ACK);
+
+        for (uint8_t row = 0; ok && row < rows; row++) {
+            const uint8_t *src = data + row * stride;
+
+            for (uint8_t i = width; ok && i > 0; i--)
+                ok = send(*src++, TW_MT_DATA_ACK);
+        }
+
+        stop();
+        return ok;
+    }
+}
+
+
+// Prescaler 1, SCL = F_CPU / (16 + 2 * TWBR). 1MHz is the most at 16MHz.
+static void setBitRate(uint32_t clock) {
+    const uint32_t divider = F_CPU / clock;
+    bitRate = divider > 16 ? (divider - 16) / 2 : 0;
+}
+
+static bool waitForBus() {
+    for (uint16_t i = TWI_TIMEOUT; i > 0; i--) {
+        if (TWCR & _BV(TWINT))
+            return true;
+    }
+
+    return false;
+}
+
+// Wire may have changed the clock in between, so it is set on every start.
+static bool start() {
+    TWSR &= ~(_BV(TWPS0) | _BV(TWPS1));
+    TWBR = bitRate;
+    TWCR = _BV(TWINT) | _BV(TWSTA) | _BV(TWEN);
+
+    return waitForBus() && TW_STATUS == TW_START;
+}
+
+static bool send(const uint8_t value, const uint8_t status) {
+    TWDR = value;
+    TWCR = _BV(TWINT) | _BV(TWEN);
+
+    return waitForBus() && TW_STATUS == status;
+}
+
+static void stop() {
+    TWCR = _BV(TWINT) | _BV(TWSTO) | _BV(TWEN);
+
+    for (uint16_t i = TWI_TIMEOUT; i > 0 && (TWCR & _BV(TWSTO)); i--)
+        ;
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef TWI_H
+#define TWI_H
+
+
+#include <stdint.h>
+
+
+//
+// Minimal TWI master for sending display data. Unlike Wire there is no
+// buffer in between: bytes are sent straight from the caller's memory, so a
+// whole frame or column window goes out in a single transaction with a
+// single start, address and control byte.
+//
+// Wire's driver owns the TWI interrupt and is linked in through the display
+// library, so transfers are polled. Wire stays usable for everything else.
+//
+namespace Twi {
+    void setup(uint8_t address, uint32_t clock);
+    bool selfTest();
+
+    uint32_t getClock();
+
+    // Sends the control byte followed by rows of width bytes each, taken
+    // stride bytes apart.
+    bool write(
+        const uint8_t control,
+        const uint8_t *data,
+        const uint8_t width,
+        const uint8_t rows = 1,
+        const uint8_t stride = 0
+    );
+
+    // Same with several bytes up front, such as commands to run before the
+    // data within the same transaction.
+    bool write(
+        const uint8_t *header,
+        const uint8_t headerSize,
+        const uint8_t *data,
+        const uint8_t width,
+        const uint8_t rows = 1,
+        const uint8_t stride = 0
+    );
+}
+
+
+#endif
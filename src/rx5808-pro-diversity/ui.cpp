@@ -1,21 +1,70 @@
 #include <stdint.h>
-#include <Adafruit_SSD1306.h>
+#include <Wire.h>
 #include <avr/pgmspace.h>
 
 #include "settings.h"
 #include "settings_internal.h"
 #include "ui.h"
+#include "benchmark.h"
+#include "timer.h"
+#include "twi.h"
+
+
+// Moves a window of columns within a range of pages left by one column.
+#define SSD1306_CONTENT_SCROLL_LEFT 0x2D
 
 
 namespace Ui {
-    OLED_CLASS display;
+    DISPLAY_CLASS display;
     bool shouldDrawUpdate = false;
     bool shouldDisplay = false;
     bool shouldFullRedraw = false;
+    bool isDimmed = false;
+
+    // Columns and pages (as a bit mask) changed since the last flush, when
+    // not flushing everything.
+    static uint8_t dirtyStart = SCREEN_WIDTH;
+    static uint8_t dirtyEnd = 0;
+    static uint8_t dirtyPages = 0;
+
+    #ifdef OLED_HW_SCROLL
+        // Region moved on the display itself, columns still to move it by
+        // and whether its right edge column still needs to be written.
+        static uint8_t scrollX = 0;
+        static uint8_t scrollW = 0;
+        static uint8_t scrollFirstPage = 0;
+        static uint8_t scrollLastPage = 0;
+        static uint8_t scrollPending = 0;
+        static bool scrollEdge = false;
+        static Timer scrollTimer = Timer(OLED_SCROLL_STEP);
+    #endif
+
+    static void flush();
+    static inline uint8_t getPageMask(
+        const uint8_t firstPage,
+        const uint8_t lastPage
+    );
+    #if defined(OLED_DIRECT_BUFFER) && !defined(SH1106)
+        static void flushColumns(
+            const uint8_t start,
+            const uint8_t end,
+            const uint8_t pages
+        );
+    #endif
+    #ifdef OLED_HW_SCROLL
+        static inline bool isScrolling();
+        static void stepScroll();
+        static void cancelScroll();
+        static void sendCommands(const uint8_t *commands, const uint8_t size);
+    #endif
 
 
     void setup() {
-        display.begin(OLED_VCCSTATE, OLED_ADDRESS);
+        #ifdef TVOUT_SCREENS
+            display.begin();
+        #else
+            display.begin(OLED_VCCSTATE, OLED_ADDRESS);
+        #endif
 
         display.setTextColor(WHITE);
         display.setTextSize(1);
@@ -24,15 +73,172 @@ namespace Ui {
         display.clearDisplay();
 
         display.begin();
+
+        #ifdef OLED_FAST_TWI
+            Twi::setup(OLED_ADDRESS, OLED_TWI_CLOCK);
+        #endif
     }
 
     void update() {
-        if (shouldDisplay) {
+        // The display wants to be left alone for a while after every scroll
+        // step, everything else waits for the next one.
+        #ifdef OLED_HW_SCROLL
+            if (isScrolling() && !scrollTimer.hasTicked())
+                return;
+        #endif
+
+        if (shouldDisplay || dirtyStart < dirtyEnd)
+            flush();
+
+        #ifdef OLED_HW_SCROLL
+            stepScroll();
+        #endif
+    }
+
+    static void flush() {
+        // Anything written into the scrolling region would be moved along
+        // with it, so the region is sent as a whole then.
+        #ifdef OLED_HW_SCROLL
+            if (shouldDisplay) {
+                scrollPending = 0;
+                scrollEdge = false;
+            } else if (
+                isScrolling() &&
+                dirtyStart < scrollX + scrollW &&
+                dirtyEnd > scrollX &&
+                (dirtyPages & getPageMask(scrollFirstPage, scrollLastPage))
+            ) {
+                cancelScroll();
+            }
+        #endif
+
+        #ifdef USE_BENCHMARK
+            const uint32_t start = micros();
+            const bool fullFrame = shouldDisplay;
+        #endif
+
+        #ifdef SH1106
+            if (shouldDisplay) {
+                display.display();
+            } else {
+                display.display(dirtyStart, dirtyEnd, dirtyPages);
+            }
+        #elif defined(OLED_DIRECT_BUFFER) && defined(OLED_FAST_TWI)
+            if (shouldDisplay) {
+                flushColumns(0, SCREEN_WIDTH, 0xFF);
+            } else {
+                flushColumns(dirtyStart, dirtyEnd, dirtyPages);
+            }
+        #elif defined(OLED_DIRECT_BUFFER)
+            if (shouldDisplay) {
+                display.display();
+            } else {
+                flushColumns(dirtyStart, dirtyEnd, dirtyPages);
+            }
+        #else
             display.display();
-            shouldDisplay = false;
-        }
+        #endif
+
+        shouldDisplay = false;
+        dirtyStart = SCREEN_WIDTH;
+        dirtyEnd = 0;
+        dirtyPages = 0;
+
+        #ifdef USE_BENCHMARK
+            Benchmark::recordFlush(micros() - start, fullFrame);
+        #endif
     }
 
+    #if defined(OLED_DIRECT_BUFFER) && !defined(SH1106)
+        // The SSD1306 window is a single range of pages, from the first to
+        // the last dirty one.
+        static inline uint8_t getFirstPage(const uint8_t pages) {
+            uint8_t page = 0;
+            while (!(pages & (1 << page)))
+                page++;
+
+            return page;
+        }
+
+        static inline uint8_t getLastPage(const uint8_t pages) {
+            uint8_t page = SCREEN_HEIGHT / 8 - 1;
+            while (!(pages & (1 << page)))
+                page--;
+
+            return page;
+        }
+    #endif
+
+    #if defined(OLED_DIRECT_BUFFER) && !defined(SH1106) && \
+        defined(OLED_FAST_TWI)
+        // Window setup and data each go out as one transaction, the column
+        // range of every page is picked straight out of the framebuffer.
+        static void flushColumns(
+            const uint8_t start,
+            const uint8_t end,
+            const uint8_t pages
+        ) {
+            const uint8_t firstPage = getFirstPage(pages);
+            const uint8_t lastPage = getLastPage(pages);
+            const uint8_t window[] = {
+                SSD1306_COLUMNADDR, start, static_cast<uint8_t>(end - 1),
+                SSD1306_PAGEADDR, firstPage, lastPage
+            };
+
+            Twi::write(0x00, window, sizeof(window));
+            Twi::write(
+                0x40,
+                display.getBuffer() + firstPage * SCREEN_WIDTH + start,
+                end - start,
+                lastPage - firstPage + 1,
+                SCREEN_WIDTH
+            );
+        }
+    #elif defined(OLED_DIRECT_BUFFER) && !defined(SH1106)
+        // Sends only the given columns of the dirty pages, the display wraps
+        // to the next page at the end of the column window by itself.
+        static void flushColumns(
+            const uint8_t start,
+            const uint8_t end,
+            const uint8_t pages
+        ) {
+            const uint8_t firstPage = getFirstPage(pages);
+            const uint8_t lastPage = getLastPage(pages);
+
+            display.ssd1306_command(SSD1306_COLUMNADDR);
+            display.ssd1306_command(start);
+            display.ssd1306_command(end - 1);
+            display.ssd1306_command(SSD1306_PAGEADDR);
+            display.ssd1306_command(firstPage);
+            display.ssd1306_command(lastPage);
+
+            const uint8_t *buffer = display.getBuffer();
+            uint8_t chunk = 0;
+
+            for (uint8_t page = firstPage; page <= lastPage; page++) {
+                const uint8_t *src = buffer + page * SCREEN_WIDTH + start;
+
+                for (uint8_t x = start; x < end; x++) {
+                    if (chunk == 0) {
+                        Wire.beginTransmission(OLED_ADDRESS);
+                        Wire.write(0x40);
+                    }
+
+                    Wire.write(*src++);
+
+                    // Keep within the 32 byte Wire buffer.
+                    if (++chunk == 16) {
+                        Wire.endTransmission();
+                        chunk = 0;
+                    }
+                }
+            }
+
+            if (chunk > 0)
+                Wire.endTransmission();
+        }
+    #endif
+
 
     void drawGraph(
         const uint8_t data[],
@@ -105,12 +311,28 @@ namespace Ui {
         }
     }
 
+    void setDimmed(bool dimmed) {
+        if (dimmed == isDimmed)
+            return;
+
+        display.dim(dimmed);
+        isDimmed = dimmed;
+    }
+
+    bool isFirstPass() {
+        #ifdef OLED_PAGED
+            return display.getPage() == 0;
+        #else
+            return true;
+        #endif
+    }
+
     void clear() {
         display.clearDisplay();
     }
 
     void clearRect(const int x, const int y, const int w, const int h) {
-        display.fillRect(x, y, w, h, BLACK);
+        fillRect(x, y, w, h, BLACK);
     }
 
 
@@ -122,7 +344,166 @@ namespace Ui {
         shouldDisplay = true;
     }
 
+    void needDisplayColumns(const uint8_t x, const uint8_t w) {
+        needDisplayRect(x, 0, w, SCREEN_HEIGHT);
+    }
+
+    void needDisplayRect(
+        const uint8_t x,
+        const uint8_t y,
+        const uint8_t w,
+        const uint8_t h
+    ) {
+        #ifdef OLED_DIRECT_BUFFER
+            if (w == 0 || h == 0 || y >= SCREEN_HEIGHT)
+                return;
+
+            if (x < dirtyStart)
+                dirtyStart = x;
+            if (x + w > dirtyEnd)
+                dirtyEnd = min(x + w, SCREEN_WIDTH);
+
+            const uint8_t firstPage = y >> 3;
+            const uint8_t lastPage = (min(y + h, SCREEN_HEIGHT) - 1) >> 3;
+            dirtyPages |= getPageMask(firstPage, lastPage);
+        #else
+            shouldDisplay = true;
+        #endif
+    }
+
+    // Rows y to y + h must be whole pages, the display can't scroll less.
+    void needDisplayScrolled(
+        const uint8_t x,
+        const uint8_t y,
+        const uint8_t w,
+        const uint8_t h,
+        const uint8_t distance
+    ) {
+        #ifdef OLED_HW_SCROLL
+            const uint8_t firstPage = y >> 3;
+            const uint8_t lastPage = (y + h - 1) >> 3;
+
+            if (
+                isScrolling() && (
+                    x != scrollX ||
+                    w != scrollW ||
+                    firstPage != scrollFirstPage ||
+                    lastPage != scrollLastPage
+                )
+            ) {
+                cancelScroll();
+            }
+
+            scrollX = x;
+            scrollW = w;
+            scrollFirstPage = firstPage;
+            scrollLastPage = lastPage;
+
+            // Fallen too far behind, send it all instead.
+            if (scrollPending + distance > min(OLED_SCROLL_BACKLOG, w - 1)) {
+                cancelScroll();
+                return;
+            }
+
+            scrollPending += distance;
+        #else
+            needDisplayRect(x, y, w, h);
+        #endif
+    }
+
     void needFullRedraw() {
         shouldFullRedraw = true;
     }
+
+
+    static inline uint8_t getPageMask(
+        const uint8_t firstPage,
+        const uint8_t lastPage
+    ) {
+        return (0xFF << firstPage) & (0xFF >> (7 - lastPage));
+    }
+
+    #ifdef OLED_HW_SCROLL
+        static inline bool isScrolling() {
+            return scrollPending > 0 || scrollEdge;
+        }
+
+        // With n columns still to go, the display shows the framebuffer n
+        // columns further right. Every step first fills in the right edge,
+        // which a step leaves undefined, then moves everything left by one.
+        static void stepScroll() {
+            if (!isScrolling() || !scrollTimer.hasTicked())
+                return;
+
+            scrollTimer.reset();
+
+            const uint8_t right = scrollX + scrollW - 1;
+
+            if (scrollEdge) {
+                const uint8_t column = right - scrollPending;
+                const uint8_t window[] = {
+                    SSD1306_COLUMNADDR, right, right,
+                    SSD1306_PAGEADDR, scrollFirstPage, scrollLastPage
+                };
+                const uint8_t *src = display.getBuffer() +
+                    scrollFirstPage * SCREEN_WIDTH + column;
+
+                sendCommands(window, sizeof(window));
+
+                #ifdef OLED_FAST_TWI
+                    Twi::write(
+                        0x40,
+                        src,
+                        1,
+                        scrollLastPage - scrollFirstPage + 1,
+                        SCREEN_WIDTH
+                    );
+                #else
+                    Wire.beginTransmission(OLED_ADDRESS);
+                    Wire.write(0x40);
+                    for (uint8_t p = scrollFirstPage; p <= scrollLastPage; p++)
+                        Wire.write(src[(p - scrollFirstPage) * SCREEN_WIDTH]);
+                    Wire.endTransmission();
+                #endif
+
+                scrollEdge = false;
+            }
+
+            if (scrollPending > 0) {
+                const uint8_t scroll[] = {
+                    SSD1306_CONTENT_SCROLL_LEFT,
+                    0x00, scrollFirstPage,
+                    0x01, scrollLastPage,
+                    0x00, scrollX, right
+                };
+
+                sendCommands(scroll, sizeof(scroll));
+
+                scrollPending--;
+                scrollEdge = true;
+            }
+        }
+
+        // Drops what is left of the scroll and sends the region as it is.
+        static void cancelScroll() {
+            scrollPending = 0;
+            scrollEdge = false;
+
+            needDisplayRect(
+                scrollX,
+                scrollFirstPage * 8,
+                scrollW,
+                (scrollLastPage - scrollFirstPage + 1) * 8
+            );
+        }
+
+        static void sendCommands(const uint8_t *commands, const uint8_t size) {
+            #ifdef OLED_FAST_TWI
+                Twi::write(0x00, commands, size);
+            #else
+                for (uint8_t i = 0; i < size; i++)
+                    display.ssd1306_command(commands[i]);
+            #endif
+        }
+    #endif
 }
@@ -2,12 +2,21 @@
 #define UI_H
 
 
-#include <Adafruit_SSD1306.h>
 #include <stdint.h>
 
 #include "settings.h"
 #include "settings_internal.h"
 
+#ifdef TVOUT_SCREENS
+    #include "display_tvout.h"
+#elif defined(OLED_PAGED)
+    #include "display_paged.h"
+#elif defined(SH1106)
+    #include "display_sh1106.h"
+#else
+    #include <Adafruit_SSD1306.h>
+#endif
+
 
 #define SCREEN_WIDTH 128
 #define SCREEN_HEIGHT 64
@@ -20,10 +29,11 @@
 
 
 namespace Ui {
-    extern OLED_CLASS display;
+    extern DISPLAY_CLASS display;
     extern bool shouldDrawUpdate;
     extern bool shouldDisplay;
     extern bool shouldFullRedraw;
+    extern bool isDimmed;
 
     void setup();
     void update();
@@ -38,14 +48,98 @@ namespace Ui {
         const uint8_t h
     );
 
+    void fillRect(
+        const int16_t x,
+        const int16_t y,
+        const int16_t w,
+        const int16_t h,
+        const uint16_t color
+    );
+    void drawBitmap(
+        const int16_t x,
+        const int16_t y,
+        const uint8_t *bitmap,
+        const int16_t w,
+        const int16_t h,
+        const uint16_t color
+    );
+
+    void drawText(
+        int16_t x,
+        const int16_t y,
+        const char *text,
+        const uint8_t size,
+        const uint16_t color = WHITE
+    );
+    void drawText(
+        int16_t x,
+        const int16_t y,
+        const __FlashStringHelper *text,
+        const uint8_t size,
+        const uint16_t color = WHITE
+    );
+    void drawNumber(
+        const int16_t x,
+        const int16_t y,
+        uint16_t number,
+        const uint8_t size,
+        const uint16_t color = WHITE
+    );
+
+    void drawScrollingGraph(
+        const uint8_t data[],
+        const uint8_t dataSize,
+        const uint8_t dataScale,
+        const uint8_t x,
+        const uint8_t y,
+        const uint8_t w,
+        const uint8_t h,
+        const uint8_t step
+    );
+    void scrollGraph(
+        const uint8_t data[],
+        const uint8_t dataSize,
+        const uint8_t dataScale,
+        const uint8_t x,
+        const uint8_t y,
+        const uint8_t w,
+        const uint8_t h,
+        const uint8_t step,
+        const uint8_t newSamples
+    );
+
     void drawDashedHLine(const int x, const int y, const int w, const int step);
     void drawDashedVLine(const int x, const int y, const int w, const int step);
 
+    void setDimmed(bool dimmed);
+
+    // With OLED_PAGED every frame is drawn once per page. Animations must
+    // only advance on the first pass.
+    bool isFirstPass();
+
     void clear();
     void clearRect(const int x, const int y, const int w, const int h);
 
     void needUpdate();
     void needDisplay();
+    void needDisplayColumns(const uint8_t x, const uint8_t w);
+    void needDisplayRect(
+        const uint8_t x,
+        const uint8_t y,
+        const uint8_t w,
+        const uint8_t h
+    );
+
+    // For a region whose content was moved left by distance columns. With
+    // OLED_HW_SCROLL the display moves it itself and only gets the columns
+    // uncovered on the right.
+    void needDisplayScrolled(
+        const uint8_t x,
+        const uint8_t y,
+        const uint8_t w,
+        const uint8_t h,
+        const uint8_t distance
+    );
     void needFullRedraw();
 }
 
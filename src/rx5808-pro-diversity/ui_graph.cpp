@@ -0,0 +1,194 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "settings.h"
+#include "settings_internal.h"
+#include "ui.h"
+
+
+//
+// Line graph with a fixed step per sample and the newest sample on the right
+// edge. When new samples arrive the graph already in the framebuffer is
+// moved left, which is a plain byte move per page, and only the new segments
+// are drawn. TV out scrolls its row major buffer through the display itself.
+// Otherwise the graph is drawn in full instead.
+//
+#define PAGE_COUNT (SCREEN_HEIGHT / 8)
+
+#if defined(OLED_DIRECT_BUFFER) || defined(TVOUT_FAST_DRAW)
+    #define GRAPH_SCROLLING
+#endif
+
+
+namespace Ui {
+    static uint8_t getPointY(
+        uint8_t dataPoint,
+        const uint8_t dataScale,
+        const uint8_t y,
+        const uint8_t h
+    );
+    static void drawSegment(
+        const uint8_t data[],
+        const uint8_t dataIndex,
+        const uint8_t dataScale,
+        const uint8_t x,
+        const uint8_t y,
+        const uint8_t h,
+        const uint8_t step
+    );
+    #ifdef OLED_DIRECT_BUFFER
+        static void shiftColumns(
+            const uint8_t x,
+            const uint8_t y,
+            const uint8_t w,
+            const uint8_t h,
+            const uint8_t shift
+        );
+    #endif
+
+
+    // Rows y to y + h are used, like drawGraph.
+    void drawScrollingGraph(
+        const uint8_t data[],
+        const uint8_t dataSize,
+        const uint8_t dataScale,
+        const uint8_t x,
+        const uint8_t y,
+        const uint8_t w,
+        const uint8_t h,
+        const uint8_t step
+    ) {
+        const uint8_t samples = min((w - 1) / step + 1, dataSize);
+        const uint8_t firstIndex = dataSize - samples;
+
+        clearRect(x, y, w, h + 1);
+
+        for (uint8_t i = 0; i < samples - 1; i++) {
+            drawSegment(
+                data,
+                firstIndex + i,
+                dataScale,
+                x + i * step,
+                y,
+                h,
+                step
+            );
+        }
+    }
+
+    void scrollGraph(
+        const uint8_t data[],
+        const uint8_t dataSize,
+        const uint8_t dataScale,
+        const uint8_t x,
+        const uint8_t y,
+        const uint8_t w,
+        const uint8_t h,
+        const uint8_t step,
+        const uint8_t newSamples
+    ) {
+        const uint8_t samples = min((w - 1) / step + 1, dataSize);
+
+        #ifdef GRAPH_SCROLLING
+            if (newSamples < samples - 1) {
+                const uint8_t graphW = (samples - 1) * step + 1;
+                const uint8_t shift = newSamples * step;
+
+                #ifdef TVOUT_FAST_DRAW
+                    display.scrollLeft(x, y, graphW, h + 1, shift);
+                #else
+                    shiftColumns(x, y, graphW, h, shift);
+                #endif
+                clearRect(x + graphW - shift, y, shift, h + 1);
+
+                const uint8_t firstIndex = dataSize - samples;
+                const uint8_t firstNew = samples - 1 - newSamples;
+                for (uint8_t i = firstNew; i < samples - 1; i++) {
+                    drawSegment(
+                        data,
+                        firstIndex + i,
+                        dataScale,
+                        x + i * step,
+                        y,
+                        h,
+                        step
+                    );
+                }
+
+                return;
+            }
+        #endif
+
+        drawScrollingGraph(data, dataSize, dataScale, x, y, w, h, step);
+    }
+
+
+    static uint8_t getPointY(
+        uint8_t dataPoint,
+        const uint8_t dataScale,
+        const uint8_t y,
+        const uint8_t h
+    ) {
+        if (dataPoint > dataScale)
+            dataPoint = dataScale;
+
+        // Inverted so higher values are drawn further up.
+        return y + h - dataPoint * h / dataScale;
+    }
+
+    static void drawSegment(
+        const uint8_t data[],
+        const uint8_t dataIndex,
+        const uint8_t dataScale,
+        const uint8_t x,
+        const uint8_t y,
+        const uint8_t h,
+        const uint8_t step
+    ) {
+        display.drawLine(
+            x,
+            getPointY(data[dataIndex], dataScale, y, h),
+            x + step,
+            getPointY(data[dataIndex + 1], dataScale, y, h),
+            WHITE
+        );
+    }
+
+    #ifdef OLED_DIRECT_BUFFER
+        // Moves columns x + shift to x + w left by shift, only touching rows
+        // y to y + h.
+        static void shiftColumns(
+            const uint8_t x,
+            const uint8_t y,
+            const uint8_t w,
+            const uint8_t h,
+            const uint8_t shift
+        ) {
+            uint8_t *buffer = display.getBuffer();
+            const uint8_t bottom = y + h;
+            const uint8_t count = w - shift;
+
+            for (uint8_t page = y >> 3; page <= bottom >> 3; page++) {
+                if (page >= PAGE_COUNT)
+                    break;
+
+                const uint8_t top = page * 8;
+
+                uint8_t mask = 0xFF;
+                if (y > top)
+                    mask &= 0xFF << (y - top);
+                if (bottom < top + 7)
+                    mask &= 0xFF >> (top + 7 - bottom);
+
+                uint8_t *dst = buffer + page * SCREEN_WIDTH + x;
+                if (mask == 0xFF) {
+                    memmove(dst, dst + shift, count);
+                    continue;
+                }
+
+                for (uint8_t i = 0; i < count; i++, dst++)
+                    *dst = (*dst & ~mask) | (dst[shift] & mask);
+            }
+        }
+    #endif
+}
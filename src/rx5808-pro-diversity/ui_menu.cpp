@@ -8,7 +8,7 @@ void Ui::MenuHelper::reset() {
 }
 
 void Ui::MenuHelper::addItem(
-    const char* text,
+    const __FlashStringHelper* text,
     const unsigned char* icon,
     const Ui::MenuHandler handler
 ) {
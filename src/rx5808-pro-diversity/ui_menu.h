@@ -11,7 +11,7 @@ namespace Ui {
     typedef void(*MenuHandler)();
 
     struct MenuItem {
-        const char* text = nullptr;
+        const __FlashStringHelper* text = nullptr;
         Ui::MenuHandler handler = nullptr;
         const unsigned char* icon = nullptr;
     };
@@ -20,7 +20,7 @@ namespace Ui {
         public:
             void reset();
             void addItem(
-                const char* text,
+                const __FlashStringHelper* text,
                 const unsigned char* icon,
                 const MenuHandler handler
             );
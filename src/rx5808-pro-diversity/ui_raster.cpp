@@ -0,0 +1,186 @@
+#include <stdint.h>
+#include <string.h>
+#include <avr/pgmspace.h>
+
+#include "settings.h"
+#include "settings_internal.h"
+#include "ui.h"
+
+
+//
+// Fills and blits working on the SSD1306 buffer layout directly: every byte
+// holds a column of 8 pixels (LSB on top), a row of 128 bytes makes a page.
+// Whole bytes are written with memset or masks instead of pixel by pixel.
+//
+// Without direct buffer access everything goes through Adafruit GFX.
+//
+#define PAGE_COUNT (SCREEN_HEIGHT / 8)
+
+
+namespace Ui {
+    #ifdef OLED_DIRECT_BUFFER
+        static inline void maskColumns(
+            uint8_t *dst,
+            uint8_t count,
+            const uint8_t mask,
+            const uint16_t color
+        );
+        static inline void writeColumn(
+            uint8_t *dst,
+            const uint8_t bits,
+            const uint16_t color
+        );
+    #endif
+
+
+    void fillRect(
+        const int16_t x,
+        const int16_t y,
+        const int16_t w,
+        const int16_t h,
+        const uint16_t color
+    ) {
+        #ifdef OLED_DIRECT_BUFFER
+            const int16_t x0 = max(x, 0);
+            const int16_t x1 = min(x + w, SCREEN_WIDTH);
+            const int16_t y0 = max(y, 0);
+            const int16_t y1 = min(y + h, SCREEN_HEIGHT);
+            if (x0 >= x1 || y0 >= y1)
+                return;
+
+            uint8_t *buffer = display.getBuffer();
+            const uint8_t width = x1 - x0;
+            const uint8_t lastPage = (y1 - 1) >> 3;
+
+            for (uint8_t page = y0 >> 3; page <= lastPage; page++) {
+                const int16_t top = page * 8;
+
+                uint8_t mask = 0xFF;
+                if (y0 > top)
+                    mask &= 0xFF << (y0 - top);
+                if (y1 < top + 8)
+                    mask &= 0xFF >> (top + 8 - y1);
+
+                uint8_t *dst = buffer + page * SCREEN_WIDTH + x0;
+                if (mask == 0xFF && color != INVERSE) {
+                    memset(dst, color == WHITE ? 0xFF : 0x00, width);
+                } else {
+                    maskColumns(dst, width, mask, color);
+                }
+            }
+        #else
+            display.fillRect(x, y, w, h, color);
+        #endif
+    }
+
+    // Row major bitmap as used by Adafruit GFX, only set bits are drawn.
+    // Blocks of 8x8 pixels are transposed into columns, which are written
+    // as is when y is page aligned and split over two pages otherwise.
+    void drawBitmap(
+        const int16_t x,
+        const int16_t y,
+        const uint8_t *bitmap,
+        const int16_t w,
+        const int16_t h,
+        const uint16_t color
+    ) {
+        #ifdef OLED_DIRECT_BUFFER
+            if (y < 0) {
+                display.drawBitmap(x, y, bitmap, w, h, color);
+                return;
+            }
+
+            uint8_t *buffer = display.getBuffer();
+            const uint8_t bytesPerRow = (w + 7) / 8;
+            const uint8_t shift = y & 7;
+
+            for (int16_t blockY = 0; blockY < h; blockY += 8) {
+                const uint8_t page = (y + blockY) >> 3;
+                if (page >= PAGE_COUNT)
+                    break;
+
+                const uint8_t rows = min(h - blockY, 8);
+
+                for (uint8_t byteX = 0; byteX < bytesPerRow; byteX++) {
+                    const uint8_t *src = bitmap + blockY * bytesPerRow + byteX;
+
+                    uint8_t columns[8] = { 0 };
+                    for (uint8_t row = 0; row < rows; row++) {
+                        uint8_t bits = pgm_read_byte(src);
+                        src += bytesPerRow;
+
+                        for (uint8_t i = 0; bits != 0; i++) {
+                            if (bits & 0x80)
+                                columns[i] |= _BV(row);
+
+                            bits <<= 1;
+                        }
+                    }
+
+                    for (uint8_t i = 0; i < 8; i++) {
+                        const int16_t px = x + byteX * 8 + i;
+                        if (byteX * 8 + i >= w)
+                            break;
+                        if (px < 0 || px >= SCREEN_WIDTH || columns[i] == 0)
+                            continue;
+
+                        uint8_t *dst = buffer + page * SCREEN_WIDTH + px;
+                        if (shift == 0) {
+                            writeColumn(dst, columns[i], color);
+                        } else {
+                            writeColumn(dst, columns[i] << shift, color);
+                            if (page + 1 < PAGE_COUNT) {
+                                writeColumn(
+                                    dst + SCREEN_WIDTH,
+                                    columns[i] >> (8 - shift),
+                                    color
+                                );
+                            }
+                        }
+                    }
+                }
+            }
+        #else
+            display.drawBitmap(x, y, bitmap, w, h, color);
+        #endif
+    }
+
+
+    #ifdef OLED_DIRECT_BUFFER
+        static inline void maskColumns(
+            uint8_t *dst,
+            uint8_t count,
+            const uint8_t mask,
+            const uint16_t color
+        ) {
+            switch (color) {
+                case WHITE:
+                    while (count--)
+                        *dst++ |= mask;
+                    break;
+
+                case BLACK:
+                    while (count--)
+                        *dst++ &= ~mask;
+                    break;
+
+                case INVERSE:
+                    while (count--)
+                        *dst++ ^= mask;
+                    break;
+            }
+        }
+
+        static inline void writeColumn(
+            uint8_t *dst,
+            const uint8_t bits,
+            const uint16_t color
+        ) {
+            switch (color) {
+                case WHITE: *dst |= bits; break;
+                case BLACK: *dst &= ~bits; break;
+                case INVERSE: *dst ^= bits; break;
+            }
+        }
+    #endif
+}
@@ -1,6 +1,5 @@
 #include "ui.h"
 #include "ui_state_menu.h"
-#include "pstr_helper.h"
 
 
 using Ui::display;
@@ -46,6 +45,9 @@ bool StateMenuHelper::handleButtons(
     if (!this->isVisible())
         return false;
 
+    if (pressType == Buttons::PressType::HOLDING_END)
+        return true;
+
     switch (button) {
         case Button::UP:
             if (--this->selectedItem < 0)
@@ -69,13 +71,13 @@ void StateMenuHelper::draw() {
     if (!this->isVisible())
         return;
 
-    if (MENU_X != MENU_TARGET_X) {
+    if (MENU_X != MENU_TARGET_X && Ui::isFirstPass()) {
         this->slideX -= 4;
         if (this->slideX < 0)
             this->slideX = 0;
     }
 
-    display.fillRect(
+    Ui::fillRect(
         MENU_X,
         0,
         MENU_W,
@@ -95,7 +97,7 @@ void StateMenuHelper::draw() {
 
     for (uint8_t i = 0; i < this->activeItems; i++) {
         if (this->selectedItem == i) {
-            display.fillRect(
+            Ui::fillRect(
                 MENU_X,
                 MENU_ITEM_H * i + yOffset,
                 MENU_ITEM_W,
@@ -104,7 +106,7 @@ void StateMenuHelper::draw() {
             );
         }
 
-        display.drawBitmap(
+        Ui::drawBitmap(
             MENU_X,
             MENU_ITEM_H * i + yOffset,
             this->menuItems[i].icon(this->state),
@@ -0,0 +1,219 @@
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+#include "settings.h"
+#include "settings_internal.h"
+#include "ui.h"
+
+
+//
+// Scaled text straight into the framebuffer. Adafruit GFX draws every set
+// pixel of a scaled glyph as its own fillRect, which makes the big channel
+// and frequency texts the most expensive part of a frame. Here every glyph
+// column is expanded once into page bytes and then written size times.
+//
+// Only digits and band letters are covered, anything else is handed to GFX,
+// just like everything without direct buffer access.
+//
+#define GLYPH_WIDTH 5
+#define GLYPH_HEIGHT 7
+#define GLYPH_SIZE_MAX 8
+
+// Enough for a column of GLYPH_SIZE_MAX plus its shift into the first page.
+#define COLUMN_PAGES_MAX ((7 + GLYPH_HEIGHT * GLYPH_SIZE_MAX + 7) / 8 + 1)
+
+
+// Same glyphs as the GFX default font.
+static const uint8_t digitGlyphs[][GLYPH_WIDTH] PROGMEM = {
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E },
+    { 0x00, 0x42, 0x7F, 0x40, 0x00 },
+    { 0x72, 0x49, 0x49, 0x49, 0x46 },
+    { 0x21, 0x41, 0x49, 0x4D, 0x33 },
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 },
+    { 0x27, 0x45, 0x45, 0x45, 0x39 },
+    { 0x3C, 0x4A, 0x49, 0x49, 0x31 },
+    { 0x41, 0x21, 0x11, 0x09, 0x07 },
+    { 0x36, 0x49, 0x49, 0x49, 0x36 },
+    { 0x46, 0x49, 0x49, 0x29, 0x1E }
+};
+
+static const char letters[] PROGMEM = "ABEFLR";
+static const uint8_t letterGlyphs[][GLYPH_WIDTH] PROGMEM = {
+    { 0x7C, 0x12, 0x11, 0x12, 0x7C },
+    { 0x7F, 0x49, 0x49, 0x49, 0x36 },
+    { 0x7F, 0x49, 0x49, 0x49, 0x41 },
+    { 0x7F, 0x09, 0x09, 0x09, 0x01 },
+    { 0x7F, 0x40, 0x40, 0x40, 0x40 },
+    { 0x7F, 0x09, 0x19, 0x29, 0x46 }
+};
+
+
+namespace Ui {
+    #ifdef OLED_DIRECT_BUFFER
+        static void drawChar(
+            const int16_t x,
+            const int16_t y,
+            const char c,
+            const uint8_t size,
+            const uint16_t color
+        );
+        static const uint8_t *getGlyph(char c);
+        static void drawGlyph(
+            const int16_t x,
+            const int16_t y,
+            const uint8_t *glyph,
+            const uint8_t size,
+            const uint16_t color
+        );
+    #endif
+
+
+    void drawText(
+        int16_t x,
+        const int16_t y,
+        const char *text,
+        const uint8_t size,
+        const uint16_t color
+    ) {
+        #ifndef OLED_DIRECT_BUFFER
+            display.setTextSize(size);
+            display.setTextColor(color);
+            display.setCursor(x, y);
+            display.print(text);
+        #else
+            for (; *text != '\0'; text++) {
+                drawChar(x, y, *text, size, color);
+                x += (GLYPH_WIDTH + 1) * size;
+            }
+        #endif
+    }
+
+    // Same for text in PROGMEM, read a character at a time.
+    void drawText(
+        int16_t x,
+        const int16_t y,
+        const __FlashStringHelper *text,
+        const uint8_t size,
+        const uint16_t color
+    ) {
+        #ifndef OLED_DIRECT_BUFFER
+            display.setTextSize(size);
+            display.setTextColor(color);
+            display.setCursor(x, y);
+            display.print(text);
+        #else
+            PGM_P src = reinterpret_cast<PGM_P>(text);
+
+            for (char c; (c = pgm_read_byte(src)) != '\0'; src++) {
+                drawChar(x, y, c, size, color);
+                x += (GLYPH_WIDTH + 1) * size;
+            }
+        #endif
+    }
+
+    void drawNumber(
+        const int16_t x,
+        const int16_t y,
+        uint16_t number,
+        const uint8_t size,
+        const uint16_t color
+    ) {
+        char text[6];
+        char *digit = &text[sizeof(text) - 1];
+
+        *digit = '\0';
+        do {
+            *--digit = '0' + number % 10;
+            number /= 10;
+        } while (number > 0);
+
+        drawText(x, y, digit, size, color);
+    }
+
+
+    #ifdef OLED_DIRECT_BUFFER
+        static void drawChar(
+            const int16_t x,
+            const int16_t y,
+            const char c,
+            const uint8_t size,
+            const uint16_t color
+        ) {
+            const uint8_t *glyph = getGlyph(c);
+
+            if (glyph != nullptr && size <= GLYPH_SIZE_MAX && y >= 0) {
+                drawGlyph(x, y, glyph, size, color);
+            } else {
+                display.drawChar(x, y, c, color, color, size);
+            }
+        }
+
+        static const uint8_t *getGlyph(char c) {
+            if (c >= '0' && c <= '9')
+                return digitGlyphs[c - '0'];
+
+            for (uint8_t i = 0; i < sizeof(letters) - 1; i++) {
+                if (pgm_read_byte(&letters[i]) == c)
+                    return letterGlyphs[i];
+            }
+
+            return nullptr;
+        }
+
+        static void drawGlyph(
+            const int16_t x,
+            const int16_t y,
+            const uint8_t *glyph,
+            const uint8_t size,
+            const uint16_t color
+        ) {
+            uint8_t *buffer = display.getBuffer();
+
+            const uint8_t shift = y & 7;
+            const uint8_t firstPage = y >> 3;
+            const uint8_t pages = (shift + GLYPH_HEIGHT * size + 7) / 8;
+            const uint8_t run = (1 << size) - 1;
+
+            for (uint8_t col = 0; col < GLYPH_WIDTH; col++) {
+                const uint8_t bits = pgm_read_byte(glyph + col);
+                if (bits == 0)
+                    continue;
+
+                // Expand the column vertically, every source row becomes a
+                // run of size bits.
+                uint8_t column[COLUMN_PAGES_MAX] = { 0 };
+                uint8_t out = shift;
+                for (uint8_t row = 0; row < GLYPH_HEIGHT; row++) {
+                    if (bits & _BV(row)) {
+                        const uint16_t mask = run << (out & 7);
+                        column[out >> 3] |= mask;
+                        column[(out >> 3) + 1] |= mask >> 8;
+                    }
+
+                    out += size;
+                }
+
+                // ...and horizontally by writing it size times.
+                for (uint8_t sx = 0; sx < size; sx++) {
+                    const int16_t px = x + col * size + sx;
+                    if (px < 0 || px >= SCREEN_WIDTH)
+                        continue;
+
+                    uint8_t *dst = buffer + firstPage * SCREEN_WIDTH + px;
+                    for (uint8_t p = 0; p < pages; p++) {
+                        if (firstPage + p >= SCREEN_HEIGHT / 8)
+                            break;
+
+                        switch (color) {
+                            case WHITE: *dst |= column[p]; break;
+                            case BLACK: *dst &= ~column[p]; break;
+                            case INVERSE: *dst ^= column[p]; break;
+                        }
+
+                        dst += SCREEN_WIDTH;
+                    }
+                }
+            }
+        }
+    #endif
+}
@@ -0,0 +1,94 @@
+#include <Arduino.h>
+#include <stdint.h>
+
+#include "settings.h"
+
+#ifdef USE_VOLTAGE_MONITORING
+
+#include "settings_internal.h"
+#include "settings_eeprom.h"
+#include "voltage.h"
+#include "adc.h"
+#include "timer.h"
+#include "beeper.h"
+
+
+//
+// PIN_VBAT is converted in the background ADC rotation every
+// VBAT_ROTATIONS rotations. That costs two conversions (settle and sample),
+// so RSSI sampling slows down by at most 2 / (VBAT_ROTATIONS * 10) with
+// diversity, well below 1%. The rate is shown on the settings screen.
+//
+static uint8_t vbatSlot;
+
+// Holds VBAT_SMOOTH times the smoothed raw value.
+static uint16_t smoothed = 0;
+
+static Timer alarmTimer = Timer(ALARM_EVERY_MSEC);
+static bool alarmDue = false;
+
+
+static void updateAlarm();
+
+
+namespace Voltage {
+    uint8_t voltage = 0;
+    Alarm alarm = Alarm::NONE;
+
+
+    void setup() {
+        vbatSlot = Adc::addSlot(PIN_VBAT, 1, VBAT_ROTATIONS);
+    }
+
+    // Run by the scheduler every TASK_PERIOD_VOLTAGE ms.
+    void update() {
+        const uint16_t raw = Adc::getResult(vbatSlot);
+        if (raw == 0)
+            return; // Not converted yet.
+
+        if (smoothed == 0) {
+            smoothed = raw * VBAT_SMOOTH;
+        } else {
+            smoothed = smoothed - smoothed / VBAT_SMOOTH + raw;
+        }
+
+        voltage = static_cast<uint32_t>(smoothed) * VBAT_PRESCALER /
+            (static_cast<uint16_t>(EepromSettings.vbatScale) * VBAT_SMOOTH) +
+            VBAT_OFFSET;
+
+        Alarm nextAlarm = Alarm::NONE;
+        if (voltage <= EepromSettings.vbatCritical) {
+            nextAlarm = Alarm::CRITICAL;
+        } else if (voltage <= EepromSettings.vbatWarning) {
+            nextAlarm = Alarm::WARNING;
+        }
+
+        if (nextAlarm != alarm) {
+            alarm = nextAlarm;
+            alarmDue = true;
+        }
+
+        updateAlarm();
+    }
+}
+
+
+// Sounds the alarm right away and then every ALARM_EVERY_MSEC.
+static void updateAlarm() {
+    if (Voltage::alarm == Voltage::Alarm::NONE)
+        return;
+
+    if (!alarmDue && !alarmTimer.hasTicked())
+        return;
+
+    alarmDue = false;
+    alarmTimer.reset();
+
+    Beeper::play(
+        Voltage::alarm == Voltage::Alarm::CRITICAL
+            ? Beeper::Pattern::BATTERY_CRITICAL
+            : Beeper::Pattern::BATTERY_WARNING
+    );
+}
+
+#endif
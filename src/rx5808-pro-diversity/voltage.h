@@ -0,0 +1,29 @@
+#ifndef VOLTAGE_H
+#define VOLTAGE_H
+
+
+#include <stdint.h>
+#include "settings.h"
+
+
+#ifdef USE_VOLTAGE_MONITORING
+
+namespace Voltage {
+    enum class Alarm : uint8_t {
+        NONE,
+        WARNING,
+        CRITICAL
+    };
+
+
+    extern uint8_t voltage; // In 0.1V.
+    extern Alarm alarm;
+
+    void setup();
+    void update();
+}
+
+#endif
+
+
+#endif